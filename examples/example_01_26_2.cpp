@@ -35,7 +35,7 @@ public:
     void fun() override
     {
         auto gl = get_global< uav_global >();
-        auto &proc_list = get_process()->get_system()->get_processes< uv::vehicle_t >( "UAVs" );
+        auto &proc_list = get_process()->get_system()->get_view< uv::vehicle_t >( "UAVs" );
         gl->measure.update( isw::uv::count_collisions( proc_list, gl->D ), get_thread_time() );
     }
 
@@ -99,7 +99,7 @@ int main()
                                   std::function< double( std::shared_ptr< std::vector< double > > ) > f =
                                       [gl, pt]( auto v )
                                   {
-                                      auto procs = pt->get_system()->template get_processes< uv::vehicle_t >( "UAVs" );
+                                      auto &procs = pt->get_system()->template get_view< uv::vehicle_t >( "UAVs" );
                                       double add, ret = 0;
                                       for ( auto &p : procs )
                                       {
@@ -11,6 +11,7 @@
 #include "process.hpp"
 #include "simulator.hpp"
 #include "system.hpp"
+#include "task_thread.hpp"
 #include "utils/customer-server/server.hpp"
 #include "utils/customer-server/supplier.hpp"
 #include "utils/customer-server/utils.hpp"
@@ -80,7 +81,6 @@ public:
         if ( auto id = p->get_id() )
             req->sender = *id;
         req->receiver = server_id;
-        req->world_key = "customers"; // sender world
         req->tag = 0;                 // generic tag
 
         sys->send_message( req );
@@ -91,56 +91,20 @@ public:
     }
 };
 
-class customer_receiver_thread : public thread_t
+// waits for the server replies instead of polling the inbox on a timer
+class customer_receiver_thread : public task_thread_t
 {
 public:
-    customer_receiver_thread() : thread_t( 0, 0, 0 ) {} // Continuous polling? Or small period?
-    // Using 0 might be dangerous if it spins. Let's use a small period or rely on step?
-    // Usually receiver threads have 0 wait if they just process inbox?
-    // If I put 0, `step` calls `schedule`. `schedule` checks `_th_time`.
-    // If I don't increase `_th_time`, it loops forever in one step? No, `step` calls `schedule` once per process per
-    // step? No, `system::step` calls `proc->schedule(_time)`. `process::schedule` calls `thread->schedule`.
-    // `thread::schedule` loops `while (_th_time <= current_time)`.
-    // So if I don't advance time, infinite loop.
-    // I should check mailbox. If empty, wait?
-    // Better: check mailbox, if message, process. Then `set_compute_time` to something?
-    // If I interpret "missed sales at time t", I process all messages arrived up to t.
-    // I can just pop all messages.
-
-    void fun() override
+    void run() override
     {
-        auto gl = get_global< shop_global >();
-        while ( auto msg = receive_message< request_t >() )
-        {
-            // Text: "receives -j denotes missed sale".
-            // Since `item` is size_t, how is -j represented?
-            // Wait, message from server?
-            // Server sends `j` or `-j`.
-            // `request_t` has `size_t item`. It cannot hold negative values.
-            // Maybe `request_t` isn't what the server sends back?
-            // The server code in `example_11_25_1` (no server there).
-            // `server.hpp` is generic on `mes_type`.
-            // If I use `request_t`, I can interpret `tag` or `quantity` as the sign?
-            // Or I can use `quantity` (int) for the signed value?
-            // Let's assume the server sends a `request_t` back with `quantity` or `tag`.
-            // The text says "sends message -j". Maybe `quantity = -j`? Or `item=j, quantity=-1`?
-            // Let's check my server implementation plan.
-
-            // I need to implement the server logic. I can use `request_t`.
-            // If missed sale, I can set `quantity = -1`.
-            // If sale, `quantity = 1`.
-
-            if ( msg->quantity < 0 )
+        receive< request_t >(
+            [this]( std::shared_ptr< request_t > msg )
             {
-                // Missed sale
-                gl->measure.update( 1, get_thread_time() );
-            }
-        }
-        // Check again next step?
-        // Optimization: checking every T (0.1s) is too expensive with many customers.
-        // We accumulate messages in the queue anyway.
-        // Check every 10 seconds or H/10.
-        set_compute_time( std::max( 10.0, gl->T * 100 ) );
+                // the server replies quantity -1 for a missed sale
+                if ( msg && msg->quantity < 0 )
+                    get_global< shop_global >()->measure.update( 1, get_thread_time() );
+                run();
+            } );
     }
 };
 
@@ -197,7 +161,6 @@ int main()
         if ( auto id = srv->get_id() )
             reply->sender = *id;
         reply->receiver = msg->sender;
-        reply->world_key = "servers";
         reply->item = product;
 
         if ( srv->database[product] > 0 )
@@ -64,7 +64,6 @@ public:
         if ( auto id = p->get_id() )
             req->sender = *id;
         req->receiver = server_id;
-        req->world_key = "customers";
         req->tag = 0;
 
         sys->send_message( req );
@@ -77,7 +76,8 @@ public:
 class customer_receiver_thread : public thread_t
 {
 public:
-    customer_receiver_thread() : thread_t( 0, 0, 0 ) {}
+    // runs only when a reply has been delivered
+    customer_receiver_thread() : thread_t( 0, 0, 0 ) { set_wake_on_delivery( true ); }
 
     void fun() override
     {
@@ -91,8 +91,6 @@ public:
                 gl->measure.update( 1, get_thread_time() );
             }
         }
-        // Optimization: check less frequently
-        set_compute_time( std::max( 10.0, gl->T * 100 ) );
     }
 };
 
@@ -141,7 +139,6 @@ public:
             if ( auto id = srv->get_id() )
                 reply->sender = *id;
             reply->receiver = msg->sender;
-            reply->world_key = "servers";
             reply->item = product;
 
             if ( srv->database[product] > 0 )
@@ -0,0 +1,186 @@
+/*
+ * File: arena.hpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This header file defines a typed slab arena keeping objects of the same type contiguous.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace isw
+{
+    /**
+     * @brief Arena constructing objects in per-type slabs, in insertion order.
+     * @details Objects of the same type are placed next to each other in chunks that never move, each chunk twice
+     * as large as the previous one. A released object leaves its cell on a free list of its slab, reused by the
+     * next object of the type. The arena destroys the objects still alive slab by slab, latest slab first and
+     * each slab in reverse construction order, and releases every chunk at once.
+     */
+    class arena_t
+    {
+    public:
+        arena_t() = default;
+        arena_t( const arena_t & ) = delete;
+        arena_t &operator=( const arena_t & ) = delete;
+        /**
+         * @brief Destroys every object not released, latest slab first.
+         */
+        ~arena_t()
+        {
+            while ( !_slabs.empty() )
+                _slabs.pop_back();
+        }
+
+        /**
+         * @brief Constructs an object in the slab of its type.
+         * @tparam T Object type.
+         * @param[in] args Constructor arguments.
+         * @return Pointer to the object, stable for the lifetime of the arena.
+         */
+        template< typename T, typename... Args >
+        T *emplace( Args &&...args )
+        {
+            auto &slot = _index[std::type_index( typeid( T ) )];
+            if ( !slot )
+            {
+                _slabs.push_back( std::make_unique< slab_t< T > >() );
+                slot = _slabs.back().get();
+            }
+            return static_cast< slab_t< T > * >( slot )->emplace( std::forward< Args >( args )... );
+        }
+
+        /**
+         * @brief Destroys an object and frees its cell for the next object of its type.
+         * @tparam T Object type, as passed to emplace.
+         * @param[in] object Object constructed by emplace and not released yet.
+         */
+        template< typename T >
+        void release( T *object )
+        {
+            static_cast< slab_t< T > * >( _index.at( std::type_index( typeid( T ) ) ) )->release( object );
+        }
+
+        /**
+         * @brief Gets the number of objects in the arena.
+         * @return Objects constructed and not released.
+         */
+        size_t size() const
+        {
+            size_t count = 0;
+            for ( auto &slab : _slabs )
+                count += slab->count;
+            return count;
+        }
+
+    private:
+        /** @brief Chunk capacity of a new slab. */
+        static constexpr size_t first_chunk = 64;
+
+        /** @brief Type-erased slab. */
+        struct slab_base_t
+        {
+            virtual ~slab_base_t() = default;
+            /** @brief Objects in the slab. */
+            size_t count = 0;
+        };
+        /** @brief Chunks of objects of type T. */
+        template< typename T >
+        struct slab_t : slab_base_t
+        {
+            /** @brief Raw storage of one object. */
+            struct alignas( T ) cell_t
+            {
+                unsigned char bytes[sizeof( T )];
+            };
+
+            ~slab_t() override
+            {
+                std::sort( _free.begin(), _free.end(), std::less< cell_t * >() );
+                while ( !_chunks.empty() )
+                {
+                    while ( _used > 0 )
+                    {
+                        cell_t *cell = &_chunks.back()[--_used];
+                        if ( !std::binary_search( _free.begin(), _free.end(), cell, std::less< cell_t * >() ) )
+                            reinterpret_cast< T * >( cell )->~T();
+                    }
+                    _chunks.pop_back();
+                    if ( !_chunks.empty() )
+                        _used = first_chunk << ( _chunks.size() - 1 );
+                }
+            }
+
+            template< typename... Args >
+            T *emplace( Args &&...args )
+            {
+                if ( !_free.empty() )
+                {
+                    // the cell stays free if the constructor throws
+                    T *object = new ( _free.back() ) T( std::forward< Args >( args )... );
+                    _free.pop_back();
+                    this->count++;
+                    return object;
+                }
+                if ( _chunks.empty() || _used == first_chunk << ( _chunks.size() - 1 ) )
+                {
+                    _chunks.emplace_back( new cell_t[first_chunk << _chunks.size()] );
+                    _used = 0;
+                }
+                T *object = new ( &_chunks.back()[_used] ) T( std::forward< Args >( args )... );
+                _used++;
+                this->count++;
+                return object;
+            }
+
+            void release( T *object )
+            {
+                object->~T();
+                _free.push_back( reinterpret_cast< cell_t * >( object ) );
+                this->count--;
+            }
+
+        private:
+            /** @brief Storage chunks, the k-th holding first_chunk * 2^k objects. */
+            std::vector< std::unique_ptr< cell_t[] > > _chunks;
+            /** @brief Cells used in the last chunk, constructed or released. */
+            size_t _used = 0;
+            /** @brief Cells of released objects, reused last in first out. */
+            std::vector< cell_t * > _free;
+        };
+
+        /** @brief Slabs in creation order. */
+        std::vector< std::unique_ptr< slab_base_t > > _slabs;
+        /** @brief Slab of each type. */
+        std::unordered_map< std::type_index, slab_base_t * > _index;
+    };
+} // namespace isw
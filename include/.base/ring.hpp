@@ -0,0 +1,122 @@
+/*
+ * File: ring.hpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This header file defines a growable single-threaded ring buffer that keeps its capacity.
+ */
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace isw
+{
+    /**
+     * @brief FIFO of values stored inline in a circular buffer.
+     * @tparam T Element type, must be default constructible and movable.
+     * @details Capacity is a power of two and doubles when full; it is never released, so a ring in steady state
+     * does not allocate. Popped and cleared slots are reset to T{}, so they do not hold on to resources.
+     */
+    template< typename T >
+    class ring_t
+    {
+    public:
+        ring_t() : _head( 0 ), _size( 0 ) {}
+
+        /**
+         * @brief Appends an element.
+         * @param[in] value Element to move into the ring.
+         */
+        void push( T &&value )
+        {
+            if ( _size == _buffer.size() )
+                _grow();
+            _buffer[( _head + _size ) & ( _buffer.size() - 1 )] = std::move( value );
+            _size++;
+        }
+
+        /**
+         * @brief Appends a copy of an element.
+         * @param[in] value Element to copy into the ring.
+         */
+        void push( const T &value ) { push( T( value ) ); }
+
+        /**
+         * @brief Gets the oldest element.
+         * @return Reference to the front element, the ring must not be empty.
+         */
+        T &front() { return _buffer[_head]; }
+
+        /**
+         * @brief Removes the oldest element, the ring must not be empty.
+         */
+        void pop()
+        {
+            _buffer[_head] = T{};
+            _head = ( _head + 1 ) & ( _buffer.size() - 1 );
+            _size--;
+        }
+
+        /**
+         * @brief Removes every element, keeping the capacity.
+         */
+        void clear()
+        {
+            for ( size_t i = 0; i < _size; i++ )
+                _buffer[( _head + i ) & ( _buffer.size() - 1 )] = T{};
+            _head = 0;
+            _size = 0;
+        }
+
+        /**
+         * @brief Gets the number of elements.
+         * @return Elements in the ring.
+         */
+        size_t size() const { return _size; }
+
+        /**
+         * @brief Checks whether the ring is empty.
+         * @return True if there is no element.
+         */
+        bool empty() const { return _size == 0; }
+
+    private:
+        /** @brief Doubles the capacity, moving the elements to the front. */
+        void _grow()
+        {
+            std::vector< T > buffer( _buffer.empty() ? 16 : _buffer.size() * 2 );
+            for ( size_t i = 0; i < _size; i++ )
+                buffer[i] = std::move( _buffer[( _head + i ) & ( _buffer.size() - 1 )] );
+            _buffer.swap( buffer );
+            _head = 0;
+        }
+
+        /** @brief Element storage, size is the capacity. */
+        std::vector< T > _buffer;
+        /** @brief Index of the oldest element. */
+        size_t _head;
+        /** @brief Number of elements. */
+        size_t _size;
+    };
+} // namespace isw
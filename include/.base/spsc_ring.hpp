@@ -0,0 +1,114 @@
+/*
+ * File: spsc_ring.hpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This header file defines a bounded lock-free single-producer single-consumer ring buffer.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace isw
+{
+    /**
+     * @brief Bounded lock-free ring buffer for exactly one producer thread and one consumer thread.
+     * @tparam T Element type, must be default constructible and movable.
+     * @details Capacity is rounded up to a power of two. Head and tail live on separate cache lines so the two
+     * threads do not false-share.
+     */
+    template< typename T >
+    class spsc_ring_t
+    {
+    public:
+        /**
+         * @brief Constructor.
+         * @param[in] capacity Minimum number of storable elements.
+         */
+        explicit spsc_ring_t( size_t capacity ) : _head( 0 ), _tail( 0 )
+        {
+            size_t size = 1;
+            while ( size < capacity )
+                size <<= 1;
+            _buffer.resize( size );
+            _mask = size - 1;
+        }
+
+        /**
+         * @brief Pushes an element (producer side).
+         * @param[in] value Element to move into the ring.
+         * @return False if the ring is full, value is left untouched.
+         */
+        bool try_push( T &&value )
+        {
+            const size_t tail = _tail.load( std::memory_order_relaxed );
+            if ( tail - _head.load( std::memory_order_acquire ) > _mask )
+                return false;
+            _buffer[tail & _mask] = std::move( value );
+            _tail.store( tail + 1, std::memory_order_release );
+            return true;
+        }
+
+        /**
+         * @brief Pops an element (consumer side).
+         * @param[out] value Destination of the popped element.
+         * @return False if the ring is empty.
+         */
+        bool try_pop( T &value )
+        {
+            const size_t head = _head.load( std::memory_order_relaxed );
+            if ( head == _tail.load( std::memory_order_acquire ) )
+                return false;
+            value = std::move( _buffer[head & _mask] );
+            _head.store( head + 1, std::memory_order_release );
+            return true;
+        }
+
+        /**
+         * @brief Checks whether the ring is empty.
+         * @return True if no element is pending.
+         */
+        bool empty() const
+        {
+            return _head.load( std::memory_order_acquire ) == _tail.load( std::memory_order_acquire );
+        }
+
+        /**
+         * @brief Gets the ring capacity.
+         * @return Maximum number of storable elements.
+         */
+        size_t capacity() const { return _mask + 1; }
+
+    private:
+        /** @brief Element storage. */
+        std::vector< T > _buffer;
+        /** @brief Index mask, capacity - 1. */
+        size_t _mask;
+        /** @brief Consumer position. */
+        alignas( 64 ) std::atomic< size_t > _head;
+        /** @brief Producer position. */
+        alignas( 64 ) std::atomic< size_t > _tail;
+    };
+} // namespace isw
@@ -26,7 +26,9 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <string>
 #include ".base/hashing.hpp"
 /*
@@ -45,4 +47,12 @@ namespace isw
 {
     /** @brief Type for world keys, represented as strings. */
     using world_key_t = std::string;
+    /** @brief Dense integer ID of an interned world key, see system_t::world_id. */
+    using world_id_t = u32_t;
+    /** @brief World ID of messages not stamped by a system. */
+    constexpr world_id_t no_world = std::numeric_limits< world_id_t >::max();
+    /** @brief Simulated time in integer ticks, see system_t::set_tick. */
+    using tick_t = int64_t;
+    /** @brief Position of an element missing from a compact index. */
+    constexpr size_t npos = std::numeric_limits< size_t >::max();
 } // namespace isw
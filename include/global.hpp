@@ -49,7 +49,7 @@ namespace isw
         global_t( const global_t &other ) noexcept = default;
         /**
          * @brief Initializes simulation-specific state.
-         * @details Clears all message channels and resets montecarlo current to 0.
+         * @details Empties all message channels in place, keeping their capacity, and resets montecarlo current to 0.
          */
         virtual void init();
         /**
@@ -0,0 +1,105 @@
+/*
+ * File: async_writer.hpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This header file defines the async_writer_t class that moves file output onto a background thread.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <thread>
+#include ".base/spsc_ring.hpp"
+
+namespace isw
+{
+    /** @brief Behaviour of an asynchronous writer when its ring buffer is full. */
+    enum class backpressure_t
+    {
+        BLOCK, /**< @brief The producer waits until the writer thread frees a slot. */
+        DROP   /**< @brief The record is discarded and counted. */
+    };
+
+    /**
+     * @brief Writes text records to a file from a dedicated background thread.
+     * @details The simulation thread pushes complete records into a lock-free SPSC ring; the writer thread drains
+     * it in batches and issues one write per batch. Memory is bounded by the ring capacity. Only one thread may
+     * push records.
+     */
+    class async_writer_t
+    {
+    public:
+        /**
+         * @brief Constructor, starts the writer thread.
+         * @param[in] stream Open output stream, ownership is transferred to the writer.
+         * @param[in] capacity Maximum number of pending records.
+         * @param[in] policy What to do when the ring is full.
+         */
+        async_writer_t( std::ofstream &&stream, size_t capacity, backpressure_t policy );
+        /**
+         * @brief Drains pending records, flushes and joins the writer thread.
+         */
+        ~async_writer_t();
+        async_writer_t( const async_writer_t & ) = delete;
+        async_writer_t &operator=( const async_writer_t & ) = delete;
+
+        /**
+         * @brief Enqueues a record.
+         * @param[in] record Text to write, including its line terminator.
+         * @return False if the record was dropped.
+         */
+        bool push( std::string &&record );
+        /**
+         * @brief Waits until every pushed record has been written and flushed.
+         */
+        void flush();
+        /**
+         * @brief Gets the number of records dropped because the ring was full.
+         * @return Dropped records count.
+         */
+        size_t dropped() const;
+
+    private:
+        /** @brief Writer thread loop. */
+        void _run();
+
+        /** @brief Pending records. */
+        spsc_ring_t< std::string > _ring;
+        /** @brief Destination stream, only touched by the writer thread. */
+        std::ofstream _stream;
+        /** @brief Full ring policy. */
+        backpressure_t _policy;
+        /** @brief Records accepted by push (producer side). */
+        size_t _pushed;
+        /** @brief Records written and flushed by the writer thread. */
+        std::atomic< size_t > _written;
+        /** @brief Records dropped by push. */
+        std::atomic< size_t > _dropped;
+        /** @brief Stop request for the writer thread. */
+        std::atomic< bool > _stop;
+        /** @brief Writer thread. */
+        std::thread _worker;
+    };
+} // namespace isw
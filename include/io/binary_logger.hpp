@@ -0,0 +1,167 @@
+/*
+ * File: binary_logger.hpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This header file defines the binary_logger_t class for logging typed simulation traces in a columnar binary format.
+ */
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "common.hpp"
+
+namespace isw
+{
+    /** @brief Storage type of a binary trace column. */
+    enum class field_type_t : u8_t
+    {
+        REAL,   /**< @brief 64-bit floating point column. */
+        INTEGER /**< @brief 64-bit signed integer column. */
+    };
+
+    /**
+     * @brief Logs typed simulation data to a columnar binary trace file.
+     * @details Same workflow as logger_t (add_field -> log_fields -> loop[add_measurement -> log_measurement]), but
+     * values are stored as raw 8-byte words in a column buffer and written one block at a time, so logging a sample
+     * costs a couple of stores instead of a formatted write. The file layout is:
+     *   - header: magic "ISWTRACE", u32 version, u32 field count, then per field u8 type, u32 name length, name;
+     *   - blocks: u32 row count, then every column of the block stored contiguously (row count * 8 bytes each).
+     * Values are written in native byte order. Use to_csv() to obtain the same text layout produced by logger_t.
+     */
+    class binary_logger_t : public std::enable_shared_from_this< binary_logger_t >
+    {
+    public:
+        /** @brief Format version written in the trace header. */
+        static constexpr u32_t version = 1;
+
+        /**
+         * @brief Factory method to create a binary logger.
+         * @param[in] path Path to the trace file, defaults to "logfile.bin".
+         * @param[in] block_rows Number of rows buffered before a block is flushed, defaults to 4096.
+         * @return Shared pointer to created logger.
+         * @throws std::runtime_error If the file cannot be opened or block_rows is 0.
+         */
+        static std::shared_ptr< binary_logger_t > create( const std::filesystem::path &path = "logfile.bin",
+                                                          size_t block_rows = 4096 );
+        /**
+         * @brief Flushes the pending block and closes the file.
+         */
+        ~binary_logger_t();
+        /**
+         * @brief Adds a typed field to the schema.
+         * @param[in] field Field name.
+         * @param[in] type Column storage type, defaults to REAL.
+         * @return Shared pointer to this logger for chaining.
+         * @throws std::runtime_error If fields are modified after logging schema.
+         */
+        std::shared_ptr< binary_logger_t > add_field( std::string_view field, field_type_t type = field_type_t::REAL );
+        /**
+         * @brief Writes the header and freezes the schema.
+         * @return Shared pointer to this logger for chaining.
+         * @throws std::runtime_error If fields already logged.
+         */
+        std::shared_ptr< binary_logger_t > log_fields();
+        /**
+         * @brief Adds a floating point measurement to the next column of the current row.
+         * @param[in] value Measurement value, converted to the column type (truncated for integer columns).
+         * @return Shared pointer to this logger for chaining.
+         * @throws std::runtime_error If the schema has not been logged, the row is already full, or the column is an
+         * integer one and value is NaN, infinite or out of the int64_t range.
+         */
+        std::shared_ptr< binary_logger_t > add_measurement( double value );
+        /**
+         * @brief Adds an integer measurement to the next column of the current row.
+         * @tparam T Integral type.
+         * @param[in] value Measurement value, converted to the column type.
+         * @return Shared pointer to this logger for chaining.
+         */
+        template< typename T, typename = std::enable_if_t< std::is_integral_v< T > > >
+        std::shared_ptr< binary_logger_t > add_measurement( T value )
+        {
+            return _add_integer( static_cast< int64_t >( value ) );
+        }
+        /**
+         * @brief Commits the current row, flushing the block when full.
+         * @return Shared pointer to this logger for chaining.
+         * @throws std::runtime_error If measurement count doesn't match field count.
+         */
+        std::shared_ptr< binary_logger_t > log_measurement();
+        /**
+         * @brief Writes the buffered rows as a block and flushes the file.
+         * @return Shared pointer to this logger for chaining.
+         */
+        std::shared_ptr< binary_logger_t > flush();
+        /**
+         * @brief Gets the number of rows committed so far.
+         * @return Total committed rows.
+         */
+        size_t rows() const;
+
+        /**
+         * @brief Converts a binary trace into the text layout produced by logger_t.
+         * @param[in] trace Path to the binary trace.
+         * @param[in] csv Path of the text file to write.
+         * @throws std::runtime_error If a file cannot be opened or the trace is malformed.
+         */
+        static void to_csv( const std::filesystem::path &trace, const std::filesystem::path &csv );
+
+    private:
+        /** @brief Private constructor.
+         * @param[in] path Path to the trace file.
+         * @param[in] block_rows Rows per block.
+         * @throws std::runtime_error If file cannot be opened.
+         */
+        binary_logger_t( const std::filesystem::path &path, size_t block_rows );
+        /** @brief Stores an integer measurement in the next column. */
+        std::shared_ptr< binary_logger_t > _add_integer( int64_t value );
+        /** @brief Returns the buffer slot of the next column, checking the row bounds. */
+        u64_t &_next_slot();
+        /** @brief Writes the buffered rows to the file. */
+        void _write_block();
+
+        /** @brief Flag to block field modifications after logging schema. */
+        bool _block; /* = false */
+        /** @brief Output stream to the trace file. */
+        std::ofstream _stream;
+        /** @brief List of field names. */
+        std::vector< std::string > _fields;
+        /** @brief List of field types. */
+        std::vector< field_type_t > _types;
+        /** @brief Column-major buffer, column c of row r at c * _block_rows + r. */
+        std::vector< u64_t > _columns;
+        /** @brief Rows per block. */
+        size_t _block_rows;
+        /** @brief Rows currently buffered. */
+        size_t _buffered;
+        /** @brief Next column of the current row. */
+        size_t _cursor;
+        /** @brief Total committed rows. */
+        size_t _rows;
+    };
+} // namespace isw
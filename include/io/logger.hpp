@@ -29,14 +29,21 @@
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <vector>
+#include "io/async_writer.hpp"
+#include "random.hpp"
 
 namespace isw
 {
+    class sampler_t;
+
     /**
      * @brief Logs simulation data to CSV files.
      * @details Manages field schema and measurement logging with chaining support.
+     * An optional sampling mode (sample_every, sample_on_change, sample_reservoir, sample_buckets) decides which
+     * records reach the file, so trace size follows the information of interest rather than the event count.
      */
     class logger_t : public std::enable_shared_from_this< logger_t >
     {
@@ -47,6 +54,10 @@ namespace isw
          * @return Shared pointer to created logger.
          */
         static std::shared_ptr< logger_t > create( const std::filesystem::path &path = "logfile.csv" );
+        /**
+         * @brief Writes the records still held by the sampling mode.
+         */
+        ~logger_t();
         /**
          * @brief Adds a field to the schema.
          * @param[in] field Field name.
@@ -66,12 +77,83 @@ namespace isw
          * @return Shared pointer to this logger for chaining.
          */
         std::shared_ptr< logger_t > add_measurement( std::string_view value );
+        /**
+         * @brief Adds a numeric measurement value.
+         * @param[in] value Measurement value, written in its shortest round-trip form.
+         * @return Shared pointer to this logger for chaining.
+         */
+        std::shared_ptr< logger_t > add_measurement( double value );
         /**
          * @brief Logs the current measurements.
          * @return Shared pointer to this logger for chaining.
          * @throws std::runtime_error If measurement count doesn't match field count.
          */
         std::shared_ptr< logger_t > log_measurement();
+        /**
+         * @brief Moves file output to a background writer thread.
+         * @param[in] capacity Maximum number of lines waiting to be written, defaults to 16384.
+         * @param[in] policy Behaviour when the buffer is full, defaults to BLOCK.
+         * @return Shared pointer to this logger for chaining.
+         * @details Lines are formatted on the calling thread and written in batches without per-line flushes.
+         * @throws std::runtime_error If the logger is already asynchronous.
+         */
+        std::shared_ptr< logger_t > set_async( size_t capacity = 1 << 14,
+                                               backpressure_t policy = backpressure_t::BLOCK );
+        /**
+         * @brief Waits until every logged line has reached the file.
+         * @return Shared pointer to this logger for chaining.
+         */
+        std::shared_ptr< logger_t > flush();
+        /**
+         * @brief Gets the number of lines dropped by the asynchronous writer.
+         * @return Dropped lines, always 0 in synchronous mode.
+         */
+        size_t dropped() const;
+
+        /*
+         * sampling modes, to be selected before log_fields
+         */
+        /**
+         * @brief Logs only one record every n.
+         * @param[in] n Decimation factor, the first record is always logged.
+         * @return Shared pointer to this logger for chaining.
+         * @throws std::runtime_error If the schema has already been logged or n is 0.
+         */
+        std::shared_ptr< logger_t > sample_every( size_t n );
+        /**
+         * @brief Logs a record only when it differs from the last logged one.
+         * @param[in] threshold Minimum absolute change of a numeric field; non-numeric fields must differ textually.
+         * @param[in] watched Names of the compared fields, empty for all of them. Leave out fields that change on
+         * every record, such as the simulated time, or every record is logged.
+         * @return Shared pointer to this logger for chaining.
+         * @throws std::runtime_error If the schema has already been logged, or, when logging the schema, if a
+         * watched field is not in it.
+         */
+        std::shared_ptr< logger_t > sample_on_change( double threshold, std::vector< std::string > watched = {} );
+        /**
+         * @brief Keeps a uniform random sample of k records (reservoir sampling).
+         * @param[in] k Number of records kept.
+         * @param[in] random Random generator used for the replacement draws.
+         * @return Shared pointer to this logger for chaining.
+         * @details The sample is written in arrival order by finish() or on destruction.
+         * @throws std::runtime_error If the schema has already been logged.
+         */
+        std::shared_ptr< logger_t > sample_reservoir( size_t k, std::shared_ptr< random_t > random );
+        /**
+         * @brief Aggregates records into windows of simulated time.
+         * @param[in] time_field Name of the field holding the simulated time.
+         * @param[in] window Width of each window.
+         * @return Shared pointer to this logger for chaining.
+         * @details One line is written per non-empty window: the window start followed by min, mean and max of every
+         * other field (header "<field>_min <field>_mean <field>_max"). The last window is written by finish().
+         * @throws std::runtime_error If the schema has already been logged or window is not positive.
+         */
+        std::shared_ptr< logger_t > sample_buckets( std::string_view time_field, double window );
+        /**
+         * @brief Writes the records held by the sampling mode (reservoir sample, last open window).
+         * @return Shared pointer to this logger for chaining.
+         */
+        std::shared_ptr< logger_t > finish();
 
     private:
         /** @brief Private constructor.
@@ -79,13 +161,25 @@ namespace isw
          * @throws std::runtime_error If file cannot be opened.
          */
         logger_t( const std::filesystem::path &path );
+        /** @brief Writes a complete line to the file or to the asynchronous writer. */
+        void _write_line( std::string &&line );
+        /** @brief Formats a record as a line and writes it. */
+        void _emit( const std::vector< std::string > &row );
+        /** @brief Writes the records still held by the sampling mode. */
+        void _drain();
+        /** @brief Installs a sampling mode, checking the schema has not been logged yet. */
+        std::shared_ptr< logger_t > _set_sampler( std::unique_ptr< sampler_t > sampler );
         /** @brief Flag to block field modifications after logging schema. */
         bool _block; /* = false */
                      /** @brief Output stream to the log file. */
         std::ofstream _stream;
+        /** @brief Background writer, owns the stream once set_async has been called. */
+        std::unique_ptr< async_writer_t > _async;
         /** @brief List of field names. */
         std::vector< std::string > _fields;
         /** @brief List of current measurements. */
         std::vector< std::string > _measurements;
+        /** @brief Sampling mode, null when every record is logged. */
+        std::unique_ptr< sampler_t > _sampler;
     };
 } // namespace isw
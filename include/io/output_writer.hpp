@@ -28,6 +28,9 @@
 
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <sstream>
+#include "io/async_writer.hpp"
 
 namespace isw
 {
@@ -53,12 +56,36 @@ namespace isw
          * @details The buffer must be later flushed with save_output
          */
         void write_line(const std::string &line);
+        /**
+         * @brief Gets the file stream.
+         * @return Reference to the file stream, in synchronous mode only.
+         * @throws std::runtime_error If the writer is asynchronous: the stream belongs to the writer thread.
+         */
         std::ofstream& get_stream();
 
+        /**
+         * @brief Moves file output to a background writer thread.
+         * @param[in] capacity Maximum number of lines waiting to be written, defaults to 4096.
+         * @param[in] policy Behaviour when the buffer is full, defaults to BLOCK.
+         * @details Text written with operator<< is collected on the calling thread and handed off as one record
+         *   whenever a manipulator (e.g. std::endl) is applied or write_line is called.
+         * @throws std::runtime_error If the writer is already asynchronous.
+         */
+        void set_async(size_t capacity = 1 << 12, backpressure_t policy = backpressure_t::BLOCK);
+        /**
+         * @brief Waits until everything written so far has reached the file.
+         */
+        void flush();
+        /**
+         * @brief Gets the number of records dropped by the asynchronous writer.
+         * @return Dropped records, always 0 in synchronous mode.
+         */
+        size_t dropped() const;
+
         // Friend template for arbitrary types T
         template<typename T>
         friend output_writer_t& operator<<(output_writer_t& writer, const T& value) {
-            writer.get_stream() << value;
+            writer._sink() << value;
             return writer;
         }
 
@@ -66,8 +93,17 @@ namespace isw
         friend output_writer_t& operator<<(output_writer_t& writer, std::ostream& (*manip)(std::ostream&));
         friend output_writer_t& operator<<(output_writer_t& writer, std::ios_base& (*manip)(std::ios_base&));
     private:
+        /** @brief Returns the stream text is formatted into: the file, or the pending record in async mode. */
+        std::ostream& _sink();
+        /** @brief Hands the pending record to the asynchronous writer. */
+        void _handoff();
+
         /** @brief Output stream to the file. */
         std::ofstream _stream;
+        /** @brief Text not yet handed to the asynchronous writer. */
+        std::ostringstream _pending;
+        /** @brief Background writer, owns the stream once set_async has been called. */
+        std::unique_ptr< async_writer_t > _async;
     };
 
     /**
@@ -47,6 +47,11 @@ namespace isw
          * @return Shared pointer to the simulator.
          */
         std::shared_ptr< simulator_t > get_simulator() const;
+        /**
+         * @brief Gets the average reset cost of the last run.
+         * @return Mean wall-clock seconds spent in system_t::init per replica, see system_t::get_reset_time.
+         */
+        double get_reset_time() const;
         /**
          * @brief Factory method to create a montecarlo_t instance.
          * @param[in] sim Shared pointer to the simulator.
@@ -73,5 +78,6 @@ namespace isw
         montecarlo_t( std::shared_ptr< simulator_t > sim );
         void _init();                        /**< @brief Initialization method (currently unused). */
         std::shared_ptr< simulator_t > _sim; /**< @brief The simulator instance. */
+        double _reset_time;                  /**< @brief Mean reset cost per replica of the last run. */
     };
 } // namespace isw
@@ -0,0 +1,152 @@
+/*
+ * File: latency_network.hpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This header file defines the latency_network_t class, a network delivering messages after per-link delays.
+ */
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "common.hpp"
+#include "network/network.hpp"
+
+namespace isw
+{
+    /** @brief Function type returning a transmission delay, sampled once per message. */
+    using latency_fn = std::function< double( void ) >;
+
+    /**
+     * @brief Network computing each message's delivery time when it is sent.
+     * @details The delay of a message is sampled from the distribution of its (sender world, receiver world) link,
+     * or from the default one. A link may also have a bandwidth, in messages per unit of time: messages on that
+     * link are then serialized, each one occupying the link for 1 / bandwidth before its latency starts. Scheduled
+     * messages wait in a heap ordered by delivery time, and the network wakes up exactly when the earliest one is
+     * due, pushing it into the receiver's input channel. Sender output channels and scanners are bypassed. Each
+     * receiver of a multicast message is scheduled on its own link, sharing the message.
+     */
+    class latency_network_t : public network_t
+    {
+    public:
+        /**
+         * @brief Constructor.
+         * @param[in] default_latency Delay used by links without a specific distribution, empty for no delay.
+         */
+        latency_network_t( latency_fn default_latency = nullptr );
+        /**
+         * @brief Factory method to create a latency network.
+         * @param[in] default_latency Delay used by links without a specific distribution, empty for no delay.
+         * @return Shared pointer to the created network.
+         */
+        static std::shared_ptr< latency_network_t > create( latency_fn default_latency = nullptr );
+        /**
+         * @brief Sets the delay distribution of a link.
+         * @param[in] from Sender world.
+         * @param[in] to Receiver world.
+         * @param[in] latency Delay distribution, negative samples are treated as 0.
+         * @return Shared pointer to this network for chaining.
+         */
+        std::shared_ptr< latency_network_t > set_latency( const world_key_t &from, const world_key_t &to,
+                                                          latency_fn latency );
+        /**
+         * @brief Limits the throughput of a link.
+         * @param[in] from Sender world.
+         * @param[in] to Receiver world.
+         * @param[in] bandwidth Messages per unit of time, 0 for unlimited.
+         * @return Shared pointer to this network for chaining.
+         */
+        std::shared_ptr< latency_network_t > set_bandwidth( const world_key_t &from, const world_key_t &to,
+                                                            double bandwidth );
+        /**
+         * @brief Schedules the delivery of a message.
+         * @param[in] msg The message being sent.
+         * @return Always true, the message never goes through the output channels.
+         * @throws std::logic_error If the network has not been initialized by system_t::init.
+         * @throws std::out_of_range If the receiver is not a process slot.
+         */
+        bool on_send( const std::shared_ptr< network::message_t > &msg ) override;
+        /**
+         * @brief Initializes the network, discarding messages in flight and link states.
+         */
+        void init() override;
+        /**
+         * @brief Gets the number of messages waiting for delivery.
+         * @return Messages in flight.
+         */
+        size_t in_flight() const;
+
+    private:
+        class delivery_thread_t;
+
+        /** @brief A scheduled delivery. */
+        struct delivery_t
+        {
+            double time;
+            u64_t seq;
+            std::shared_ptr< network::message_t > msg;
+            process_handle_t to;
+        };
+        /** @brief Heap ordering, earliest delivery first and send order among ties. */
+        struct later_t
+        {
+            bool operator()( const delivery_t &a, const delivery_t &b ) const
+            {
+                return a.time > b.time || ( a.time == b.time && a.seq > b.seq );
+            }
+        };
+        /** @brief Per-link configuration and state. */
+        struct link_t
+        {
+            latency_fn latency;
+            double bandwidth = 0;
+            double busy_until = 0;
+        };
+
+        /** @brief Schedules the delivery of a message to one receiver, null if retired. */
+        void _schedule( const std::shared_ptr< network::message_t > &msg, process_handle_t to,
+                        const process_t *receiver, double now );
+        /** @brief Delivers every message due at the current time. */
+        void _deliver( double current_time );
+        /** @brief Rebuilds _routes from the configured links whose worlds exist. */
+        void _resolve_links();
+
+        /** @brief Scheduled deliveries. */
+        std::priority_queue< delivery_t, std::vector< delivery_t >, later_t > _heap;
+        /** @brief Configured links. */
+        std::unordered_map< std::pair< world_key_t, world_key_t >, link_t > _links;
+        /** @brief Configured links by (sender world ID, receiver world ID), packed in 64 bits. */
+        std::unordered_map< u64_t, link_t * > _routes;
+        /** @brief Number of system worlds when _routes was built, links are resolved again when it changes. */
+        size_t _resolved_worlds;
+        /** @brief Delay of links without a specific distribution. */
+        latency_fn _default_latency;
+        /** @brief Send counter, used to keep ties in send order. */
+        u64_t _seq;
+        /** @brief Thread waking up at the earliest delivery time. */
+        std::shared_ptr< delivery_thread_t > _thread;
+    };
+} // namespace isw
@@ -26,28 +26,42 @@
  */
 #pragma once
 #include <memory>
-#include <queue>
+#include ".base/ring.hpp"
 #include "common.hpp"
 
 namespace isw::network
 {
     /**
      * @brief Base class for messages in the network simulation.
-     * @details Provides common attributes for message passing: sender ID, receiver ID, and timestamp.
+     * @details Provides common attributes for message passing: sender ID, receiver ID, and timestamp. The header
+     * is a fixed size POD, the sender world is carried as an interned ID (see system_t::world_key to resolve it).
      */
     class message_t
     {
     public:
         virtual ~message_t() = default; /**< @brief Virtual destructor for polymorphic deletion. */
-        size_t receiver;                /**< @brief ID of the receiving process. */
+        size_t receiver;                /**< @brief ID of the receiving process, or multicast_receiver. */
         double timestamp;               /**< @brief Time when the message was sent. */
         size_t sender;                  /**< @brief ID of the sending process. */
         size_t sender_rel;				/**< @brief Relative ID of the sending process. */
-        world_key_t world_key;        	/**< @brief World key of the sending process. */
+        world_id_t world_id = no_world; /**< @brief Interned world ID of the sending process, set by the system. */
+        u32_t receiver_generation = 0;  /**< @brief Generation of the receiver slot at send time, set by the system. */
+        size_t tag = 0;                 /**< @brief User tag, see thread_t::receive_selective. */
+        u32_t recipients = 0;           /**< @brief Receivers list slot of a multicast message, set by the system. */
     };
 
-    /** @brief Type alias for a message channel, implemented as a queue of shared pointers to messages. */
-    using channel_t = std::queue< std::shared_ptr< message_t > >;
+    /**
+     * @brief Receiver of a message sent to several processes, see system_t::multicast.
+     * @details Such a message has no receiver generation, its receivers are listed in the system slot given by
+     * message_t::recipients.
+     */
+    constexpr size_t multicast_receiver = npos;
+
+    /**
+     * @brief Type alias for a message channel, a FIFO of shared pointers to messages.
+     * @details A ring buffer: emptying it releases the messages but keeps its capacity.
+     */
+    using channel_t = ring_t< std::shared_ptr< message_t > >;
 } // namespace isw::network
 
 // HOW TO USE DYNAMIC CAST WITH message_t
@@ -36,6 +36,26 @@ namespace isw
      */
     class network_t : public isw::process_t
     {
+    public:
+        /**
+         * @brief Called by system_t::send_message before the message is queued.
+         * @param[in] msg The message being sent.
+         * @return True if the network takes charge of the delivery, false to queue it in the sender's output
+         * channel as usual (default).
+         */
+        virtual bool on_send( const std::shared_ptr< network::message_t > &msg );
+        /**
+         * @brief Called by system_t::spawn_process once the process is registered.
+         * @param[in] id Absolute ID of the new process.
+         * @details Registers the process to every scanner thread owning it.
+         */
+        virtual void on_spawn( size_t id );
+        /**
+         * @brief Called by system_t::retire_process once the process is removed.
+         * @param[in] id Absolute ID of the retired process.
+         * @details Unregisters the process from every scanner thread.
+         */
+        virtual void on_retire( size_t id );
     };
 
     /**
@@ -57,7 +77,7 @@ namespace isw
          * @brief Executes the scanning and message dispatching logic.
          * @details Randomly shuffles the process list when all have been scanned, then selects the next process,
          * checks its output channel, and if a message is present, forwards it to the receiver's input channel.
-         * Rebuilds the scanner list if the number of processes has changed.
+         * Processes added since the last visit are registered first.
          */
         virtual void fun() override;
         virtual void on_start_scan();
@@ -67,11 +87,143 @@ namespace isw
          * @details Populates the _scanner vector with indices from 0 to processes.size()-1 and sets _current to 0.
          */
         virtual void init() override;
+        /**
+         * @brief Tells whether the scanner is responsible for a process.
+         * @param[in] id Absolute process ID.
+         * @return True if the process output channel is scanned by this scanner (default for every process).
+         */
+        virtual bool owns( size_t id ) const;
+        /**
+         * @brief Adds a process to the scan, in O(1).
+         * @param[in] id Absolute process ID.
+         * @details During a round the process is put at a uniformly random position among the ones still to visit,
+         * otherwise it joins the next round. Registering a process already scanned does nothing.
+         */
+        void register_id( size_t id );
+        /**
+         * @brief Removes a process from the scan, in O(1).
+         * @param[in] id Absolute process ID.
+         * @details The order of the processes still to visit in the current round stays uniformly random.
+         * Unregistering a process not scanned does nothing.
+         */
+        void unregister_id( size_t id );
 
     protected:
+        /**
+         * @brief Visits the next process of the current round and forwards at most one of its messages.
+         * @return True if a message has been forwarded.
+         * @details Starts a new shuffled round (calling on_start_scan) when the previous one is over.
+         */
+        bool _scan_one();
+        /**
+         * @brief Called when the number of processes differs from the one last seen.
+         * @details Registers the new owned processes, keeping the scanner timing and the current round. The list
+         * is rebuilt only if the system has fewer processes than before.
+         */
+        virtual void _on_topology_change();
+        /**
+         * @brief Rebuilds the scanner list from the owned processes and ends the current round.
+         */
+        void _rebuild();
+        /** @brief Swaps two entries of the scanner list, keeping _position in sync. */
+        void _swap( size_t i, size_t j );
+
         /** @brief List of process indices to scan. */
         std::vector< size_t > _scanner;
+        /** @brief Position of each process in _scanner, indexed by process ID, npos if not scanned. */
+        std::vector< size_t > _position;
         /** @brief Current index in the scanner list. */
         size_t _current; // scanned_idx
+        /** @brief Number of processes in the system when the scanner list was last updated. */
+        size_t _seen;
+    };
+
+    /** @brief How a shard_scanner_t assigns processes to shards. */
+    enum class shard_mode_t
+    {
+        HASH, /**< @brief By process ID, id % shards. */
+        WORLD /**< @brief By world, world ID % shards, a world is served by a single shard. */
+    };
+
+    /**
+     * @brief Scanner serving a disjoint slice of the processes.
+     * @details Several shard scanners with the same shard count and mode partition the processes, each one with its
+     * own shuffle and timing, so the delivery rate per process does not drop with the total number of processes.
+     * Processes added to the system are registered by the owning shard only.
+     */
+    class shard_scanner_t : public scanner_t
+    {
+    public:
+        /**
+         * @brief Constructs a shard scanner.
+         * @param[in] shard Index of the shard served, in [0, shards).
+         * @param[in] shards Number of shards.
+         * @param[in] mode Partitioning mode.
+         * @param[in] c_time Compute time.
+         * @param[in] s_time Sleep time.
+         * @param[in] th_time Thread time, defaults to 0.0.
+         */
+        shard_scanner_t( size_t shard, size_t shards, shard_mode_t mode, double c_time, double s_time,
+                         double th_time = 0.0 );
+        /**
+         * @brief Tells whether a process belongs to the shard.
+         * @param[in] id Absolute process ID.
+         * @return True if the process is assigned to this shard.
+         */
+        bool owns( size_t id ) const override;
+
+    protected:
+        /** @brief Index of the shard served. */
+        size_t _shard;
+        /** @brief Number of shards. */
+        size_t _shards;
+        /** @brief Partitioning mode. */
+        shard_mode_t _mode;
+    };
+
+    /**
+     * @brief Scanner forwarding several messages per activation.
+     * @details Each activation keeps visiting processes in the same random per-round order used by scanner_t,
+     * forwarding at most one message per visit (subject to filter()), until the batch size is reached or a whole
+     * round of visits finds nothing to forward. Every extra message moved in one activation is a system step saved
+     * with respect to scanner_t.
+     */
+    class batch_scanner_t : public scanner_t
+    {
+    public:
+        /**
+         * @brief Constructs a batching scanner.
+         * @param[in] batch Maximum messages forwarded per activation, 0 forwards everything due.
+         * @param[in] c_time Compute time.
+         * @param[in] s_time Sleep time.
+         * @param[in] th_time Thread time, defaults to 0.0.
+         */
+        batch_scanner_t( size_t batch, double c_time, double s_time, double th_time = 0.0 );
+        /**
+         * @brief Forwards up to batch messages.
+         */
+        virtual void fun() override;
+        /**
+         * @brief Resets the scanner and its counters.
+         */
+        virtual void init() override;
+        /**
+         * @brief Gets the number of system steps saved in the current run.
+         * @return Messages forwarded beyond the first of each activation.
+         */
+        size_t saved_steps() const;
+        /**
+         * @brief Gets the number of messages forwarded in the current run.
+         * @return Forwarded messages.
+         */
+        size_t forwarded() const;
+
+    protected:
+        /** @brief Maximum messages per activation, 0 for unbounded. */
+        size_t _batch;
+        /** @brief Messages forwarded in the current run. */
+        size_t _forwarded;
+        /** @brief System steps saved in the current run. */
+        size_t _saved_steps;
     };
 }
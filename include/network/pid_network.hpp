@@ -26,6 +26,8 @@
  */
 #pragma once
 
+#include <memory>
+#include <vector>
 #include "network/network.hpp"
 
 // TODO: documentation
@@ -38,6 +40,19 @@ namespace isw
     constexpr double KD = 0.01;
     constexpr double DV_ALPHA = 0.2;
 
+    /**
+     * @brief Gains and limits of a pid_scanner_t controller, defaulting to the library constants.
+     */
+    struct pid_gains_t
+    {
+        double kp = KP;                 /**< @brief Proportional gain. */
+        double ki = KI;                 /**< @brief Integral gain. */
+        double kd = KD;                 /**< @brief Derivative gain. */
+        double dv_alpha = DV_ALPHA;     /**< @brief Smoothing factor of the derivative term. */
+        double s_time_min = S_TIME_MIN; /**< @brief Minimum scanner sleep time. */
+        double s_time_max = S_TIME_MAX; /**< @brief Maximum scanner sleep time. */
+    };
+
     /**
      * @brief Thread responsible for scanning processes and dispatching messages between them.
      * @details This class implements a message passing mechanism where it randomly selects processes
@@ -48,19 +63,40 @@ namespace isw
     public:
         /**
          * @brief Constructs a pid-scanner thread with specified timing parameters.
+         * @param[in] obj_occupancy Target mean output channel occupancy.
          * @param[in] th_time Thread time, defaults to 0.0.
+         * @param[in] error_threshold Errors below this value reset the integral term.
+         * @param[in] gains Controller gains and sleep time limits.
          */
-        pid_scanner_t( double obj_occupancy = 1, double th_time = 0.0, double error_threshold = 0 );
+        pid_scanner_t( double obj_occupancy = 1, double th_time = 0.0, double error_threshold = 0,
+                       pid_gains_t gains = {} );
         virtual void on_start_scan() override;
         /**
          * @brief Initializes the scanner with the current list of processes.
          * @details Populates the _scanner vector with indices from 0 to processes.size()-1 and sets _current to 0.
          */
         virtual void init() override;
+        /**
+         * @brief Sets the controller gains, effective from the next scan round.
+         * @param[in] gains Controller gains and sleep time limits.
+         */
+        void set_gains( const pid_gains_t &gains );
+        /**
+         * @brief Gets the controller gains.
+         * @return Current gains.
+         */
+        const pid_gains_t &get_gains() const;
+        /**
+         * @brief Gets the mean absolute occupancy error measured since the last init.
+         * @return Mean of |occupancy - target| over the scan rounds, 0 if none.
+         */
+        double mean_abs_error() const;
 
     protected:
+        pid_gains_t _gains;
         double _obj_occupancy, _integral, 
             _prev_error, _prev_dv, _last_time,
-            _error_threshold;
+            _error_threshold, _abs_error_sum;
+        size_t _samples;
     };
 }
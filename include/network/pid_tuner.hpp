@@ -0,0 +1,84 @@
+/*
+ * File: pid_tuner.hpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This header file defines the pid_tuner_t optimizer searching the gains of pid_scanner_t threads.
+ */
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "network/pid_network.hpp"
+#include "optimizer.hpp"
+#include "simulator.hpp"
+
+namespace isw
+{
+    /**
+     * @brief Tunes the gains of every pid_scanner_t of a system by Monte Carlo random search.
+     * @details Each candidate (kp, ki, kd) is sampled uniformly within bounds, the other fields are kept from the
+     * lower bound. A candidate is scored by running the simulator runs times and averaging the scanners' mean
+     * absolute occupancy error. The number of candidates is the global optimizer budget; the best gains are applied
+     * to the scanners, the global optimizer result and parameters are left as they were before tune.
+     */
+    class pid_tuner_t : public optimizer_t< double >
+    {
+    public:
+        /**
+         * @brief Constructor.
+         * @param[in] sim Simulator running the system to tune.
+         * @param[in] runs Simulations per candidate.
+         * @throws std::runtime_error If runs is 0 or the system has no pid_scanner_t.
+         */
+        pid_tuner_t( std::shared_ptr< simulator_t > sim, size_t runs = 1 );
+        /**
+         * @brief Scores a candidate.
+         * @param[in,out] arguments Candidate gains, (kp, ki, kd).
+         * @return Mean absolute occupancy error.
+         */
+        double obj_fun( std::vector< double > &arguments ) override;
+        /**
+         * @brief Searches the best gains and applies them.
+         * @param[in] min Lower bounds of kp, ki, kd, and value of the other fields.
+         * @param[in] max Upper bounds of kp, ki, kd.
+         * @return The best gains found.
+         * @throws std::runtime_error If the global optimizer budget is 0.
+         */
+        pid_gains_t tune( const pid_gains_t &min, const pid_gains_t &max );
+        /**
+         * @brief Gets the score of the gains found by the last tune.
+         * @return Mean absolute occupancy error of the best gains.
+         */
+        double get_best_error() const;
+
+    private:
+        /** @brief Builds gains from a candidate. */
+        pid_gains_t _gains_of( const std::vector< double > &arguments ) const;
+
+        std::shared_ptr< simulator_t > _sim;
+        std::vector< std::shared_ptr< pid_scanner_t > > _scanners;
+        pid_gains_t _base;
+        size_t _runs;
+        double _best_error;
+    };
+}
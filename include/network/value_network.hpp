@@ -0,0 +1,236 @@
+/*
+ * File: value_network.hpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This header file defines the value_network_t class, a network passing messages by value in ring buffers.
+ */
+#pragma once
+
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <variant>
+#include <vector>
+#include ".base/ring.hpp"
+#include "common.hpp"
+#include "network/network.hpp"
+#include "system.hpp"
+
+namespace isw
+{
+    /**
+     * @brief Network carrying a closed set of message types by value.
+     * @tparam Variant std::variant of the message types, which need not derive from network::message_t.
+     * @details Messages are stored inline, in a pending ring and then in one inbox ring per receiver, instead of
+     * one heap object and shared_ptr each: once the rings have grown to their working size the message path does
+     * not allocate. Each message is moved to its inbox delay after it was sent; the delay being the same for every
+     * message, the pending ring is in due order and the network, idle while nothing is pending, wakes up when its
+     * oldest message is due. Messages to processes retired in the meantime are dropped. This path is
+     * separate from system_t::send_message: receivers poll their inbox with try_receive or receive, and wait
+     * delivery (task threads, wake on delivery mode) only watches the process input channel.
+     */
+    template< typename Variant >
+    class value_network_t : public network_t
+    {
+    public:
+        /** @brief Message value type. */
+        using value_t = Variant;
+        /** @brief A message with its routing header. */
+        struct envelope_t
+        {
+            size_t sender = 0;                /**< @brief Absolute ID of the sender. */
+            size_t receiver = 0;              /**< @brief Absolute ID of the receiver. */
+            double timestamp = 0;             /**< @brief Send time. */
+            u32_t receiver_generation = 0;    /**< @brief Receiver slot generation at send time. */
+            value_t value;                    /**< @brief The message. */
+        };
+
+        /**
+         * @brief Constructor.
+         * @param[in] delay Time between the send and the delivery of a message.
+         */
+        value_network_t( double delay = 0 ) : _delay( delay ) {}
+        /**
+         * @brief Factory method to create a value network.
+         * @param[in] delay Time between the send and the delivery of a message.
+         * @return Shared pointer to the created network.
+         */
+        static std::shared_ptr< value_network_t > create( double delay = 0 )
+        {
+            return std::make_shared< value_network_t >( delay );
+        }
+
+        /**
+         * @brief Sends a message.
+         * @tparam T Message type, one of the Variant alternatives.
+         * @param[in] from Sending thread.
+         * @param[in] receiver Absolute ID of the receiving process.
+         * @param[in] value The message.
+         * @throws std::out_of_range If receiver is not a live process.
+         */
+        template< typename T >
+        void send( const thread_t &from, size_t receiver, T &&value )
+        {
+            assert( _thread ); // MAKE SURE THE SYSTEM HAS BEEN INITIALIZED
+            auto system = get_system();
+            const double now = system->get_current_time();
+            _pending.push( { from.get_process()->get_id().value(), receiver, now,
+                             system->get_handle( receiver ).generation, value_t( std::forward< T >( value ) ) } );
+            if ( _thread->get_thread_time() == std::numeric_limits< double >::infinity() )
+                _thread->set_thread_time( now + _delay );
+        }
+
+        /**
+         * @brief Gets the oldest message of a thread's process without removing it.
+         * @param[in] to Receiving thread.
+         * @return Pointer to the message, nullptr if the inbox is empty.
+         */
+        const envelope_t *peek( const thread_t &to )
+        {
+            auto &inbox = _inbox_of( to );
+            return inbox.empty() ? nullptr : &inbox.front();
+        }
+
+        /**
+         * @brief Receives the oldest message of a thread's process if it is a T.
+         * @tparam T Expected message type.
+         * @param[in] to Receiving thread.
+         * @param[out] out Destination of the message.
+         * @return False if the inbox is empty or its oldest message is not a T, which is then left in place.
+         */
+        template< typename T >
+        bool try_receive( const thread_t &to, T &out )
+        {
+            auto &inbox = _inbox_of( to );
+            if ( inbox.empty() )
+                return false;
+            auto value = std::get_if< T >( &inbox.front().value );
+            if ( !value )
+                return false;
+            out = std::move( *value );
+            inbox.pop();
+            return true;
+        }
+
+        /**
+         * @brief Receives the oldest message of a thread's process, whatever its type.
+         * @param[in] to Receiving thread.
+         * @param[in] visitor Callable accepting every message type, applied with std::visit.
+         * @return False if the inbox is empty.
+         */
+        template< typename F >
+        bool receive( const thread_t &to, F &&visitor )
+        {
+            auto &inbox = _inbox_of( to );
+            if ( inbox.empty() )
+                return false;
+            std::visit( std::forward< F >( visitor ), inbox.front().value );
+            inbox.pop();
+            return true;
+        }
+
+        /**
+         * @brief Gets the number of messages waiting for delivery.
+         * @return Pending messages.
+         */
+        size_t pending() const { return _pending.size(); }
+
+        /**
+         * @brief Initializes the network, discarding pending and undelivered messages in place.
+         */
+        void init() override
+        {
+            if ( !_thread )
+            {
+                _thread = std::make_shared< delivery_thread_t >( *this );
+                add_thread( _thread );
+            }
+            process_t::init();
+            _pending.clear();
+            for ( auto &inbox : _inboxes )
+                inbox.clear();
+        }
+
+        /**
+         * @brief Empties the inbox of a retired process.
+         * @param[in] id Absolute ID of the retired process.
+         */
+        void on_retire( size_t id ) override
+        {
+            network_t::on_retire( id );
+            if ( id < _inboxes.size() )
+                _inboxes[id].clear();
+        }
+
+    private:
+        /** @brief Thread of the network, scheduled only while messages are pending. */
+        class delivery_thread_t : public thread_t
+        {
+        public:
+            delivery_thread_t( value_network_t &network ) :
+                thread_t( 0, 0, std::numeric_limits< double >::infinity() ), _network( network )
+            {
+            }
+            void fun() override { _network._deliver( get_thread_time() ); }
+
+        private:
+            value_network_t &_network;
+        };
+
+        /** @brief Moves every pending message due at the current time to its receiver's inbox. */
+        void _deliver( double current_time )
+        {
+            auto system = get_system();
+            for ( ; !_pending.empty() && _pending.front().timestamp + _delay <= current_time; _pending.pop() )
+            {
+                auto &envelope = _pending.front();
+                if ( !system->is_alive( { envelope.receiver, envelope.receiver_generation } ) )
+                    continue;
+                if ( envelope.receiver >= _inboxes.size() )
+                    _inboxes.resize( envelope.receiver + 1 );
+                _inboxes[envelope.receiver].push( std::move( envelope ) );
+            }
+            _thread->set_thread_time( _pending.empty() ? std::numeric_limits< double >::infinity()
+                                                       : _pending.front().timestamp + _delay );
+        }
+
+        /** @brief Gets the inbox of a thread's process. */
+        ring_t< envelope_t > &_inbox_of( const thread_t &to )
+        {
+            const size_t id = to.get_process()->get_id().value();
+            if ( id >= _inboxes.size() )
+                _inboxes.resize( id + 1 );
+            return _inboxes[id];
+        }
+
+        /** @brief Delay between the send and the delivery of a message. */
+        double _delay;
+        /** @brief Messages sent and not delivered yet, in send order. */
+        ring_t< envelope_t > _pending;
+        /** @brief Delivered messages, indexed by receiver ID. */
+        std::vector< ring_t< envelope_t > > _inboxes;
+        /** @brief Delivery thread. */
+        std::shared_ptr< delivery_thread_t > _thread;
+    };
+} // namespace isw
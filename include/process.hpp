@@ -27,8 +27,13 @@
  */
 #pragma once
 #include <cassert>
+#include <deque>
 #include <memory>
 #include <optional>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
 #include <vector>
 #include "common.hpp"
 #include "network/message.hpp"
@@ -58,19 +63,19 @@ namespace isw
          * schedule process threads at current_time
          */
         /**
-         * @brief Schedules all threads at the current time.
+         * @brief Schedules all active threads at the current time.
          * @param[in] current_time The current simulation time.
-         * @details Shuffles the threads randomly and calls schedule on each.
+         * @details Calls schedule on each active thread, inactive threads cost nothing.
          */
         void schedule( double current_time );
         /**
          * @brief Gets the associated system.
-         * @return Shared pointer to the system.
+         * @return Shared pointer to the system, nullptr if none or if it has been destroyed.
          */
         std::shared_ptr< system_t > get_system() const;
         /**
-         * @brief Returns the minimum thread time among all threads.
-         * @return The next update time, or infinity if no threads.
+         * @brief Returns the minimum thread time among active threads.
+         * @return The next update time, or infinity if no active threads.
          */
         double next_update_time() const;
         /**
@@ -80,12 +85,21 @@ namespace isw
          * @details Sets the process pointer in the thread.
          */
         std::shared_ptr< process_t > add_thread( std::shared_ptr< thread_t > thread );
+        /**
+         * @brief Gets the threads of the process.
+         * @return Reference to vector of thread pointers.
+         */
+        const std::vector< std::shared_ptr< thread_t > > &get_threads() const;
         /**
          * @brief Sets the process ID.
          * @param[in] id The ID to set.
+         * @param[in] world World key.
+         * @param[in] relative_id Relative ID in the world.
+         * @param[in] world_id Interned ID of the world.
          */
         void set_id( size_t id, std::optional< world_key_t > world = std::nullopt,
-                     std::optional< size_t > relative_id = std::nullopt );
+                     std::optional< size_t > relative_id = std::nullopt,
+                     std::optional< world_id_t > world_id = std::nullopt );
         /**
          * @brief Gets the process ID.
          * @return Optional containing the ID if set.
@@ -94,10 +108,15 @@ namespace isw
 
         std::optional< size_t > get_relative_id() const;
         std::optional< world_key_t > get_world_key() const;
+        /**
+         * @brief Gets the interned ID of the process world.
+         * @return Optional containing the world ID if registered.
+         */
+        std::optional< world_id_t > get_world_id() const;
 
         /**
          * @brief Initializes the process and its threads.
-         * @details Calls init on all threads.
+         * @details Calls init on all threads and reactivates them.
          */
         virtual void init();
 
@@ -116,7 +135,7 @@ namespace isw
 
         /**
          * @brief Sets the system for this process.
-         * @param[in] system Shared pointer to the system.
+         * @param[in] system Shared pointer to the system, only a weak reference is kept.
          */
         void set_system( std::shared_ptr< system_t > system );
 
@@ -138,6 +157,14 @@ namespace isw
          */
         static std::shared_ptr< process_t > create( std::string name = "default_process" );
 
+        /**
+         * @brief Wakes the threads waiting for a message.
+         * @param[in] time Delivery time, the woken threads are scheduled at it.
+         * @details Called by system_t::deliver after pushing into the process input channel, O(1) when no thread
+         * waits.
+         */
+        void notify_delivery( double time );
+
     private:
         /** @brief Optional process ID for system identification. */
         std::optional< size_t > _id;
@@ -145,14 +172,73 @@ namespace isw
         std::optional< size_t > _relative_id;
         /** @brief Optional process World Key for system identification. */
         std::optional< world_key_t > _world_key;
-        /** @brief The associated system. */
-        std::shared_ptr< system_t > _system;
+        /** @brief Optional interned ID of the process world. */
+        std::optional< world_id_t > _world_id;
+        /** @brief The associated system, not owned: the system owns its processes. */
+        std::weak_ptr< system_t > _system;
         /** @brief List of threads in this process. */
         std::vector< std::shared_ptr< thread_t > > _threads;
         /** @brief Name of the process. */
         std::string _name;
         /** @brief Deactivation Flag */
         bool _is_active;
+        /** @brief Active threads, the only ones scheduled, in insertion order when the process is scheduled. */
+        std::vector< thread_t * > _active_threads;
+        /** @brief Whether _active_threads has been appended to or left with unlisted entries since it was sorted. */
+        bool _threads_dirty;
+        /** @brief Whether the active threads are being scheduled, unlisted ones are then left in place. */
+        bool _scheduling;
+
+        /** @brief A slot holding a message set aside by thread_t::receive_selective. */
+        struct aside_t
+        {
+            /** @brief Arrival order among set aside messages, unique across slot reuses. */
+            u64_t seq;
+            /** @brief The message, nullptr once taken. */
+            std::shared_ptr< network::message_t > msg;
+        };
+        /** @brief Reference to a slot of _aside, stale once its message has been taken. */
+        struct aside_ref_t
+        {
+            size_t slot;
+            u64_t seq;
+        };
+        /** @brief Set aside messages in arrival order, as slot references dropped lazily once stale. */
+        struct aside_queue_t
+        {
+            std::deque< aside_ref_t > refs;
+            /** @brief References still valid. */
+            size_t live = 0;
+        };
+        /** @brief Slots of the set aside messages, recycled. */
+        std::vector< aside_t > _aside;
+        /** @brief Free slots of _aside. */
+        std::vector< size_t > _free_aside;
+        /** @brief Every set aside message. */
+        aside_queue_t _aside_all;
+        /** @brief Set aside messages by dynamic type, whatever their tag. */
+        std::unordered_map< std::type_index, aside_queue_t > _aside_by_type;
+        /** @brief Set aside messages by dynamic type then by tag. */
+        std::unordered_map< std::type_index, std::unordered_map< size_t, aside_queue_t > > _aside_by_tag;
+        /** @brief Number of set aside messages. */
+        size_t _aside_count;
+        /** @brief Arrival counter of set aside messages. */
+        u64_t _aside_seq;
+        /** @brief Threads waiting for a message, not listed in _active_threads. */
+        std::vector< thread_t * > _parked;
+
+        /** @brief Adds or removes a thread from the active threads, in O(1). */
+        void _set_thread_active( thread_t *thread, bool active );
+        /** @brief Drops unlisted entries from the active threads and sorts them by insertion order, if they changed. */
+        void _sort_threads();
+        /** @brief Moves a thread from the active threads to the waiting ones. */
+        void _park( thread_t *thread );
+        /** @brief Sets a message aside in the queues of every message, of its type and of its type and tag. */
+        void _set_aside( std::shared_ptr< network::message_t > msg );
+        /** @brief Drops the stale references at the front of a queue, and all of them once they outnumber the rest. */
+        void _trim( aside_queue_t &queue );
+        /** @brief Takes the oldest set aside message of a type (any if null) and tag (any if empty), or nullptr. */
+        std::shared_ptr< network::message_t > _take_aside( const std::type_index *type, std::optional< size_t > tag );
     };
 
 
@@ -215,7 +301,7 @@ namespace isw
         template< typename T = process_t >
         std::shared_ptr< T > get_process() const
         {
-            auto casted = std::dynamic_pointer_cast< T >( _process );
+            auto casted = std::dynamic_pointer_cast< T >( _process.lock() );
             assert( casted.get() != nullptr );
             return casted;
         }
@@ -223,12 +309,13 @@ namespace isw
         /**
          * @brief Schedules the thread if its time has come.
          * @param[in] current_time Current simulation time.
-         * @details If thread time <= current time, calls fun() and updates thread time.
+         * @details If thread time <= current time, calls fun() and updates thread time. In wake on delivery mode
+         * the thread is parked instead when the process input channel is empty (see wait_delivery).
          */
         void schedule( double current_time );
         /**
          * @brief Sets the parent process.
-         * @param[in] process Shared pointer to the process.
+         * @param[in] process Shared pointer to the process, only a weak reference is kept.
          */
         void set_process( std::shared_ptr< process_t > process );
 
@@ -242,6 +329,19 @@ namespace isw
          * @param[in] active The active state to set.
          */
         void set_active( bool active );
+        /**
+         * @brief Sets the wake on delivery mode.
+         * @param[in] wake If true, the thread only runs when its process has messages to receive.
+         * @details Instead of firing every compute + sleep time and finding an empty inbox, the thread stays out of
+         * the scheduler, with thread time at infinity, until a message is delivered to its process, and it is then
+         * scheduled at the delivery time. While messages are pending it keeps running every compute + sleep time.
+         */
+        void set_wake_on_delivery( bool wake );
+        /**
+         * @brief Gets the wake on delivery mode.
+         * @return True if the thread only runs when its process has messages to receive.
+         */
+        bool wakes_on_delivery() const;
 
 
         /**
@@ -254,21 +354,9 @@ namespace isw
         template< typename T, typename = std::enable_if_t< std::is_base_of_v< isw::network::message_t, T > > >
         void send_message( std::size_t receiver_id, T &msg )
         {
-            const std::shared_ptr< process_t > process = this->get_process();
-            assert( process->get_id().has_value() );
-
-            const std::shared_ptr< system_t > system = process->get_system(); // questa
-            assert( system.get() != nullptr );
-
-            // set common base fields
             auto &base = static_cast< isw::network::message_t & >( msg );
             base.receiver = receiver_id;
-            base.timestamp = system->get_current_time();
-            base.sender = process->get_id().value();              // assert
-            base.world_key = process->get_world_key().value();    // assert
-            base.sender_rel = process->get_relative_id().value(); // assert
-
-            system->send_message( std::make_shared< T >( std::move( msg ) ) );
+            get_process()->get_system()->send_message( _stamp( msg ) );
         }
 
         /**
@@ -282,10 +370,37 @@ namespace isw
         template< typename T, typename = std::enable_if_t< std::is_base_of_v< isw::network::message_t, T > > >
         void send_message( world_key_t world, size_t rel_id, T &msg )
         {
-            const std::shared_ptr< system_t > system = _process->get_system();
+            const std::shared_ptr< system_t > system = get_process()->get_system();
             send_message< T >( system->get_abs_id( world, rel_id ), msg );
         }
 
+        /**
+         * @brief Sends one message to several processes.
+         * @tparam T Message type, must derive from message_t.
+         * @param[in] receiver_ids IDs of the receiving processes.
+         * @param[in,out] msg The message to send.
+         * @details The message is allocated once and every receiver gets the same pointer, with receiver set to
+         * network::multicast_receiver (see system_t::multicast). Receivers must not modify it.
+         */
+        template< typename T, typename = std::enable_if_t< std::is_base_of_v< isw::network::message_t, T > > >
+        void multicast( const std::vector< size_t > &receiver_ids, T &msg )
+        {
+            get_process()->get_system()->multicast( _stamp( msg ), receiver_ids );
+        }
+
+        /**
+         * @brief Sends one message to every process of a world.
+         * @tparam T Message type, must derive from message_t.
+         * @param[in] world The world key, this thread's process receives it too if it belongs to the world.
+         * @param[in,out] msg The message to send.
+         * @details Same as multicast, in O(world size) without relative ID lookups (see system_t::broadcast).
+         */
+        template< typename T, typename = std::enable_if_t< std::is_base_of_v< isw::network::message_t, T > > >
+        void broadcast( const world_key_t &world, T &msg )
+        {
+            get_process()->get_system()->broadcast( _stamp( msg ), world );
+        }
+
         /**
          * @brief Gets the global state, cast to type T.
          * @tparam T Type to cast to, defaults to global_t.
@@ -303,15 +418,21 @@ namespace isw
          * @brief Receives a message from the process's input queue.
          * @tparam T Message type, defaults to message_t.
          * @return Shared pointer to the received message, or nullptr if none.
+         * @details Messages set aside by receive_selective are received first, oldest first, since they arrived
+         * before the ones still in the input queue.
          */
         template< typename T = network::message_t >
         std::shared_ptr< T > receive_message()
         {
-            assert( _process.get() != nullptr ); // MAKE SURE THIS THREAD IS ASSOCIATED TO A PROCESS
-            auto proc_id = _process->get_id();
-            assert( proc_id.has_value() );       // MAKE SURE THIS THREAD'S PROCESS IS REGISTERD IN THE SYSTEM
-            auto global = _process->get_system()->get_global();
+            const auto process = _process.lock();
+            assert( process.get() != nullptr ); // MAKE SURE THIS THREAD IS ASSOCIATED TO A PROCESS
+            auto proc_id = process->get_id();
+            assert( proc_id.has_value() );      // MAKE SURE THIS THREAD'S PROCESS IS REGISTERD IN THE SYSTEM
+            auto global = process->get_system()->get_global();
 
+            // set aside messages arrived first
+            if ( auto msg = process->_take_aside( nullptr, std::nullopt ) )
+                return std::dynamic_pointer_cast< T >( msg );
             auto &queue = global->get_channel_in()[proc_id.value()];
             if ( queue.empty() )
                 return nullptr;
@@ -319,11 +440,58 @@ namespace isw
             auto front_msg = queue.front();
             queue.pop();
             // // todo asset
-            assert( front_msg->receiver == proc_id.value() );
+            assert( front_msg->receiver == proc_id.value() || front_msg->receiver == network::multicast_receiver );
             // JUST TO BE SURE INSTEAD OF A DESTRUCTIVE ASSERT
             // IF RECEIVER IS WRONG SOMETHING WENT REALLY WRONG IN THE LIBRARY
             return std::dynamic_pointer_cast< T >( front_msg );
         }
+        /**
+         * @brief Receives the oldest message of a given type, and optionally tag, without losing the others.
+         * @tparam T Message type, matched against the exact dynamic type of the messages, network::message_t matches
+         * any type.
+         * @param[in] tag Required message tag, any tag if empty.
+         * @return Shared pointer to the received message, or nullptr if none matches.
+         * @details Messages taken from the input queue while looking for a match are set aside by the process instead
+         * of being dropped, in arrival order queues of every message, of each type and of each type and tag. Later
+         * selective receives with a type, with or without a tag, and without type or tag, find them in amortized
+         * O(1); a tag without a type looks at each type. Each message is moved at most once. receive_message takes
+         * set aside messages first, so both can be mixed without reordering. Set aside messages count for
+         * has_message, and so keep the wake on delivery threads of the process running until received.
+         */
+        template< typename T >
+        std::shared_ptr< T > receive_selective( std::optional< size_t > tag = std::nullopt )
+        {
+            const auto process = _process.lock();
+            assert( process.get() != nullptr ); // MAKE SURE THIS THREAD IS ASSOCIATED TO A PROCESS
+            auto proc_id = process->get_id();
+            assert( proc_id.has_value() );      // MAKE SURE THIS THREAD'S PROCESS IS REGISTERD IN THE SYSTEM
+
+            constexpr bool any = std::is_same_v< T, network::message_t >;
+            const std::type_index type( typeid( T ) );
+            if ( auto msg = process->_take_aside( any ? nullptr : &type, tag ) )
+                return std::static_pointer_cast< T >( msg );
+            auto &queue = process->get_system()->get_global()->get_channel_in()[proc_id.value()];
+            while ( !queue.empty() )
+            {
+                auto msg = std::move( queue.front() );
+                queue.pop();
+                if ( ( any || std::type_index( typeid( *msg ) ) == type ) && ( !tag || msg->tag == *tag ) )
+                    return std::static_pointer_cast< T >( msg );
+                process->_set_aside( std::move( msg ) );
+            }
+            return nullptr;
+        }
+        /**
+         * @brief Checks whether the process's input queue, or its set aside messages, hold a message.
+         * @return True if the process has a message to receive.
+         */
+        bool has_message() const;
+        /**
+         * @brief Suspends the thread until a message is delivered to its process.
+         * @details The thread leaves the scheduler and its time goes to infinity. It is scheduled again at the
+         * delivery time of the next message (see process_t::notify_delivery), or when it is reactivated.
+         */
+        void wait_delivery();
         /**
          * @brief Pure virtual function to be implemented by subclasses.
          * @details Contains the thread's logic.
@@ -347,9 +515,39 @@ namespace isw
         double _initial_c_time;
         /** @brief Initial sleep time. */
         double _initial_s_time;
-        /** @brief Parent process. */
-        std::shared_ptr< process_t > _process;
+        /** @brief Parent process, not owned: the process owns its threads. */
+        std::weak_ptr< process_t > _process;
         /** @brief Deactivation Flag */
         bool _is_active; // assume spherical cow
+        /** @brief Position in the parent process threads, the order of its active threads. */
+        size_t _order;
+        /** @brief Whether the thread is listed in the parent process active threads. */
+        bool _listed;
+        /** @brief Position in the parent process active threads, npos if not there. */
+        size_t _active_pos;
+        /** @brief Whether the thread waits for a message (see wait_delivery). */
+        bool _parked;
+        /** @brief Wake on delivery mode flag. */
+        bool _wake_on_delivery;
+
+        /** @brief Sets the timestamp and sender fields of a message and moves it into a new allocation. */
+        template< typename T >
+        std::shared_ptr< T > _stamp( T &msg )
+        {
+            const std::shared_ptr< process_t > process = get_process();
+            assert( process->get_id().has_value() );
+
+            const std::shared_ptr< system_t > system = process->get_system(); // questa
+            assert( system.get() != nullptr );
+
+            // set common base fields
+            auto &base = static_cast< isw::network::message_t & >( msg );
+            base.timestamp = system->get_current_time();
+            base.sender = process->get_id().value();              // assert
+            base.sender_rel = process->get_relative_id().value(); // assert
+            return std::make_shared< T >( std::move( msg ) );
+        }
+
+        friend class process_t;
     };
 } // namespace isw
@@ -32,8 +32,11 @@
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <typeindex>
+#include <typeinfo>
 #include <unordered_map>
 #include <vector>
+#include ".base/arena.hpp"
 #include "common.hpp"
 #include "global.hpp"
 #include "network/message.hpp"
@@ -47,8 +50,21 @@ namespace isw
         size_t rel_id;
     };
 
+    /**
+     * @brief Reference to a process slot that detects slot reuse.
+     * @details A slot's generation is bumped each time its process is retired and each time the slot is reused, so
+     * neither a handle taken before the retirement nor a message sent to the empty slot matches the next process.
+     */
+    struct process_handle_t
+    {
+        size_t id;        /**< @brief Absolute process ID (slot). */
+        u32_t generation; /**< @brief Generation of the slot when the handle was taken. */
+    };
+
     class process_t;
     class network_t;
+    struct pid_gains_t;
+    enum class shard_mode_t;
     using process_ptr_t = std::shared_ptr< process_t >;
     /**
      * @brief Manages the overall simulation system including processes, networks, and worlds.
@@ -56,6 +72,8 @@ namespace isw
      */
     class system_t : public std::enable_shared_from_this< system_t >
     {
+        friend class process_t;
+
     public:
         /**
          * @brief Constructor.
@@ -65,12 +83,24 @@ namespace isw
         system_t( std::shared_ptr< global_t > global, const std::string &name = "default_system" );
         /**
          * @brief Initializes the system.
-         * @details Initializes global, processes, and networks, resets time to 0.
+         * @details Restores the population of the previous run, initializes global, resets time to 0, then
+         * initializes networks and processes (in ID order), so messages sent by process inits are kept. Processes spawned once the previous run had started (by its first step)
+         * are retired, and the ones it retired are spawned again in their slots, so every replica starts from the
+         * same processes with the same IDs; handles taken during a run are stale afterwards. Spawns and
+         * retirements made before the first step belong to the initial population. Its wall-clock duration is
+         * recorded, see get_reset_time.
          */
         virtual void init();
+        /**
+         * @brief Gets the cost of the last reset.
+         * @return Wall-clock seconds spent in the last init, 0 before the first one.
+         */
+        double get_reset_time() const;
         /**
          * @brief Advances the simulation by one step.
-         * @details Updates time to the next event time, schedules processes and networks.
+         * @details Updates time to the next event time, schedules active processes and networks. Inactive
+         * processes cost nothing. Processes are scheduled in ID order, and their threads in insertion order,
+         * whatever the history of (de)activations.
          */
         virtual void step();
         /**
@@ -92,9 +122,46 @@ namespace isw
          * @return Shared pointer to this system.
          */
         std::shared_ptr< system_t > add_network( std::shared_ptr< network_t > net );
-        // TODO: add documentation
+        /**
+         * @brief Adds a network whose scanner forwards several messages per activation.
+         * @param[in] batch Maximum messages per activation, 0 forwards everything due.
+         * @param[in] nc_time Compute time for scanner.
+         * @param[in] ns_time Sleep time for scanner.
+         * @param[in] nth_time Thread time for scanner.
+         * @return Shared pointer to this system.
+         */
+        std::shared_ptr< system_t > add_batch_network( size_t batch = 0, double nc_time = 0.1, double ns_time = 0.1,
+                                                       double nth_time = 0 );
+        /**
+         * @brief Adds a network with one scanner thread per shard, each one serving a disjoint slice of processes.
+         * @param[in] shards Number of shards.
+         * @param[in] mode Partitioning mode, by process ID hash or by world.
+         * @param[in] nc_time Compute time for scanners.
+         * @param[in] ns_time Sleep time for scanners.
+         * @param[in] nth_time Thread time for scanners.
+         * @return Shared pointer to this system.
+         */
+        std::shared_ptr< system_t > add_sharded_network( size_t shards, shard_mode_t mode, double nc_time = 0.1,
+                                                         double ns_time = 0.1, double nth_time = 0 );
+        /**
+         * @brief Adds a network whose scanner adapts its sleep time to keep a target output channel occupancy.
+         * @param[in] obj_occupancy Target mean number of messages waiting per process.
+         * @param[in] th_time Thread time for scanner.
+         * @param[in] error_threshold Errors below this value reset the integral term.
+         * @return Shared pointer to this system.
+         */
         std::shared_ptr< system_t > add_pid_network( double obj_occupancy = 1, double th_time = 0.0,
                                                      double error_threshold = 0 );
+        /**
+         * @brief Adds a pid network with custom controller gains.
+         * @param[in] gains Controller gains and sleep time limits.
+         * @param[in] obj_occupancy Target mean number of messages waiting per process.
+         * @param[in] th_time Thread time for scanner.
+         * @param[in] error_threshold Errors below this value reset the integral term.
+         * @return Shared pointer to this system.
+         */
+        std::shared_ptr< system_t > add_pid_network( const pid_gains_t &gains, double obj_occupancy = 1,
+                                                     double th_time = 0.0, double error_threshold = 0 );
         /**
          * @brief Registers a process to a specific world.
          * @param[in] p Shared pointer to the process.
@@ -102,6 +169,93 @@ namespace isw
          * @return Shared pointer to this system.
          */
         std::shared_ptr< system_t > add_process( process_ptr_t p, world_key_t world = "default" );
+        /**
+         * @brief Registers a process, reusing the slot of a retired one if any.
+         * @param[in] p Shared pointer to the process.
+         * @param[in] world World key, defaults to "default".
+         * @return Handle of the process.
+         * @details Networks are notified through network_t::on_spawn. Relative IDs are ranks in the world, so
+         * reusing a slot renumbers the processes of the world that follow it.
+         */
+        process_handle_t spawn_process( process_ptr_t p, world_key_t world = "default" );
+        /**
+         * @brief Constructs a process in the system arena and registers it.
+         * @tparam P Process type.
+         * @param[in] world World key.
+         * @param[in] args Constructor arguments of P.
+         * @return Shared pointer to the process, it must not outlive the system.
+         * @details Processes of the same type are stored contiguously in insertion order, and so are visited by
+         * step, instead of one heap allocation each. Once retired and no longer referenced, the process is
+         * destroyed and its storage reused by the next emplaced process of its type.
+         */
+        template< typename P, typename... Args >
+        std::shared_ptr< P > emplace_process( world_key_t world, Args &&...args )
+        {
+            std::shared_ptr< P > p( _arena.emplace< P >( std::forward< Args >( args )... ),
+                                    [this]( P *process ) { _arena.release( process ); } );
+            spawn_process( p, world );
+            return p;
+        }
+        /**
+         * @brief Constructs a thread in the system arena and adds it to a process.
+         * @tparam T Thread type.
+         * @param[in] process Process of the system.
+         * @param[in] args Constructor arguments of T.
+         * @return Shared pointer to the thread, it must not outlive the system.
+         * @details Threads of the same type are stored contiguously in insertion order. A thread is destroyed with
+         * its last reference, normally with its process, and its storage reused by the next emplaced thread of its
+         * type.
+         */
+        template< typename T, typename P, typename... Args >
+        std::shared_ptr< T > emplace_thread( const std::shared_ptr< P > &process, Args &&...args )
+        {
+            std::shared_ptr< T > thread( _arena.emplace< T >( std::forward< Args >( args )... ),
+                                         [this]( T *object ) { _arena.release( object ); } );
+            process->add_thread( thread );
+            return thread;
+        }
+        /**
+         * @brief Removes a process, freeing its slot for later spawns.
+         * @param[in] handle Handle of the process.
+         * @throws std::out_of_range If the handle is stale.
+         * @details The process channels are emptied in place, the slot generation is bumped so that messages
+         * still addressed to it are dropped on delivery, and networks are notified through network_t::on_retire.
+         * The following processes of the world are renumbered.
+         */
+        void retire_process( process_handle_t handle );
+        /**
+         * @brief Gets the handle of a live process.
+         * @param[in] id Absolute process ID.
+         * @return Handle with the current generation of the slot.
+         * @throws std::out_of_range If there is no live process in the slot.
+         */
+        process_handle_t get_handle( size_t id ) const;
+        /**
+         * @brief Checks whether a handle still refers to a live process.
+         * @param[in] handle Handle of the process.
+         * @return True if the process has not been retired.
+         */
+        bool is_alive( process_handle_t handle ) const;
+        /**
+         * @brief Gets the IDs of live processes.
+         * @return Reference to the compact vector of live process IDs, in no particular order.
+         */
+        const std::vector< size_t > &live_processes() const;
+        /**
+         * @brief Delivers a message to its receiver's input channel.
+         * @param[in] msg The message.
+         * @return False if the receiver has been retired since the message was sent, the message is dropped.
+         * @details Must be used by every network to deliver messages.
+         */
+        bool deliver( const std::shared_ptr< network::message_t > &msg );
+        /**
+         * @brief Delivers a message to one receiver's input channel.
+         * @param[in] msg The message.
+         * @param[in] to Handle of the receiver taken at send time.
+         * @return False if the receiver has been retired since, the message is dropped.
+         * @details For networks delivering each receiver of a multicast message on its own (see recipients).
+         */
+        bool deliver( const std::shared_ptr< network::message_t > &msg, process_handle_t to );
         /**
          * @brief Retrieves the absolute ID of a process in a specific world.
          * @param[in] world World key.
@@ -152,6 +306,8 @@ namespace isw
             {
                 for ( auto &proc : _processes )
                 {
+                    if ( !proc )
+                        continue;
                     auto casted = std::dynamic_pointer_cast< T >( proc );
                     if ( !casted )
                         continue;
@@ -162,11 +318,45 @@ namespace isw
             return procs;
         }
 
+        /**
+         * @brief Gets the processes of a world that are of type T, as a cached view.
+         * @tparam T Process type, processes of other types are skipped.
+         * @param[in] world World key.
+         * @return Reference to the raw pointers of the matching processes, ordered by ID.
+         * @throws std::out_of_range If world not found.
+         * @details Unlike get_processes, nothing is allocated or cast on a hit: the view is rebuilt only when a
+         * process of the world has been spawned or retired since the last call. The reference stays valid for the
+         * lifetime of the system and is refreshed in place, pointers must not be kept across spawns and retirements.
+         */
+        template< typename T >
+        const std::vector< T * > &get_view( const world_key_t &world )
+        {
+            const world_id_t id = world_id( world );
+            auto &view = _views[id][std::type_index( typeid( T ) )];
+            if ( !view.procs )
+                view.procs = std::make_shared< std::vector< T * > >();
+            auto &procs = *std::static_pointer_cast< std::vector< T * > >( view.procs );
+            if ( view.version != _world_versions[id] )
+            {
+                procs.clear();
+                for ( auto pid : _worlds.at( world ) )
+                    if ( auto casted = dynamic_cast< T * >( _processes[pid].get() ) )
+                        procs.push_back( casted );
+                view.version = _world_versions[id];
+            }
+            return procs;
+        }
+
         /**
          * @brief Gets all processes in the system.
-         * @return Reference to vector of all process pointers.
+         * @return Reference to vector of all process pointers, indexed by ID, nullptr for retired slots.
          */
         const std::vector< process_ptr_t > &get_processes() const;
+        /**
+         * @brief Gets all networks in the system.
+         * @return Reference to vector of network pointers.
+         */
+        const std::vector< std::shared_ptr< network_t > > &get_networks() const;
         /**
          * @brief Gets the global state, cast to type T.
          * @tparam T Type to cast to, defaults to global_t.
@@ -191,17 +381,112 @@ namespace isw
          * @return Number of worlds.
          */
         size_t total_worlds() const;
+        /**
+         * @brief Gets the interned ID of a world.
+         * @param[in] world World key.
+         * @return Dense world ID, in [0, total_worlds()), assigned when the first process of the world is added.
+         * @throws std::out_of_range If world not found.
+         */
+        world_id_t world_id( const world_key_t &world ) const;
+        /**
+         * @brief Resolves an interned world ID.
+         * @param[in] id World ID.
+         * @return Reference to the world key.
+         * @throws std::out_of_range If id is not a world ID.
+         */
+        const world_key_t &world_key( world_id_t id ) const;
         /**
          * @brief Sends a message to a process by absolute ID.
          * @param[in] msg Shared pointer to the message.
-         * @details Pushes the message to the receiver's output channel.
+         * @throws std::out_of_range If the receiver is not a process slot.
+         * @details Stamps the sender world ID and the receiver slot generation, a message sent to a retired process
+         * is dropped on delivery even if the slot has been reused since. Then offers the message to every network (see network_t::on_send),
+         * if none takes it the message is pushed to the sender's output channel.
          */
         void send_message( const std::shared_ptr< network::message_t > msg );
+        /**
+         * @brief Sends a single message to several processes.
+         * @param[in] msg Shared pointer to the message, shared by every receiver.
+         * @param[in] receivers Absolute IDs of the receiving processes.
+         * @throws std::out_of_range If a receiver is not a live process.
+         * @details The message travels as one message with receiver network::multicast_receiver: it takes one slot
+         * of the sender's output channel and deliver pushes the same pointer into the input channel of every
+         * receiver still alive. Does nothing if receivers is empty.
+         */
+        void multicast( const std::shared_ptr< network::message_t > msg, const std::vector< size_t > &receivers );
+        /**
+         * @brief Sends a single message to every process of a world.
+         * @param[in] msg Shared pointer to the message, shared by every receiver.
+         * @param[in] world World key, the sender is a receiver too if it belongs to the world.
+         * @throws std::out_of_range If world not found.
+         * @details Same as multicast, the receivers are read directly from the world.
+         */
+        void broadcast( const std::shared_ptr< network::message_t > msg, const world_key_t &world );
+        /**
+         * @brief Gets the receivers of a multicast message not delivered yet.
+         * @param[in] msg A message with receiver network::multicast_receiver.
+         * @return Reference to the handles of the receivers, taken at send time.
+         */
+        const std::vector< process_handle_t > &recipients( const network::message_t &msg ) const;
+        /**
+         * @brief Releases the receivers list of a multicast message.
+         * @param[in] msg A message with receiver network::multicast_receiver.
+         * @details Called by deliver, networks delivering each receiver on their own must call it once they are
+         * done with the list.
+         */
+        void release_recipients( const network::message_t &msg );
+        /**
+         * @brief Records that a message has left a sender's output channel.
+         * @param[in] sender Absolute ID of the sender whose output channel has been popped.
+         * @details Must be called by every network popping output channels to keep the occupancy counters exact.
+         */
+        void on_dequeue( size_t sender );
+        /**
+         * @brief Gets the number of messages waiting in the output channels.
+         * @return Total outstanding messages, maintained incrementally (O(1)).
+         */
+        size_t outstanding_messages() const;
+        /**
+         * @brief Gets the number of messages waiting in the output channels of a world.
+         * @param[in] world World key.
+         * @return Outstanding messages sent by processes of the world.
+         * @throws std::out_of_range If world not found.
+         */
+        size_t outstanding_messages( const world_key_t &world ) const;
         /**
          * @brief Gets the current simulation time.
          * @return Current time.
          */
         double get_current_time() const;
+        /**
+         * @brief Sets the integer time base.
+         * @param[in] tick Duration of a tick, 0 for continuous time (the default).
+         * @throws std::runtime_error If tick is negative.
+         * @details With a tick, threads advance by whole ticks: each compute + sleep time (noise included) is
+         * rounded to the nearest tick, at least one, and added to the thread time as an integer. Scheduled times
+         * are then exact multiples of the tick, so threads with the same period tie exactly, long horizons do not
+         * drift and results do not depend on floating point rounding.
+         */
+        void set_tick( double tick );
+        /**
+         * @brief Gets the integer time base.
+         * @return Duration of a tick, 0 for continuous time.
+         */
+        double get_tick() const;
+        /**
+         * @brief Converts a time to ticks, rounding to the nearest one.
+         * @param[in] time Finite time.
+         * @return Number of ticks.
+         * @throws std::logic_error If no tick has been set.
+         */
+        tick_t to_ticks( double time ) const;
+        /**
+         * @brief Converts ticks to a time.
+         * @param[in] ticks Number of ticks.
+         * @return Time, always the same double for the same ticks.
+         * @throws std::logic_error If no tick has been set.
+         */
+        double to_time( tick_t ticks ) const;
         /**
          * @brief Factory method to create a system.
          * @param[in] global Shared pointer to global, defaults to new.
@@ -212,18 +497,100 @@ namespace isw
                                                    std::string name = "default_system" );
 
     private:
+        /** @brief Storage of emplaced processes and threads, declared first to be destroyed last. */
+        arena_t _arena;
         /** @brief Current simulation time. */
         double _time;
+        /** @brief Duration of a tick, 0 for continuous time. */
+        double _tick;
+        /** @brief Wall-clock seconds spent in the last init. */
+        double _reset_time;
         /** @brief List of all processes. */
         std::vector< process_ptr_t > _processes;
         /** @brief List of networks. */
         std::vector< std::shared_ptr< network_t > > _networks;
         /** @brief Map of worlds to sets of process IDs. */
         std::unordered_map< world_key_t, std::set< size_t > > _worlds;
+        /** @brief Interned world IDs. */
+        std::unordered_map< world_key_t, world_id_t > _world_ids;
+        /** @brief World keys, indexed by world ID. */
+        std::vector< world_key_t > _world_keys;
+        /** @brief World ID of each process slot. */
+        std::vector< world_id_t > _world_of;
         /** @brief Global state. */
         std::shared_ptr< global_t > _global;
+        /** @brief Messages waiting in the output channels. */
+        size_t _outstanding;
+        /** @brief Messages waiting in the output channels, per world. */
+        std::unordered_map< world_key_t, size_t > _world_outstanding;
+        /** @brief Per-process pointer to the counter of its world in _world_outstanding. */
+        std::vector< size_t * > _outstanding_of;
         /** @brief System name. */
         const std::string _name;
+        /** @brief Generation of each process slot. */
+        std::vector< u32_t > _generations;
+        /** @brief Retired slots, reused last in first out. */
+        std::vector< size_t > _free_slots;
+        /** @brief Receivers lists of the multicast messages in flight, recycled. */
+        std::vector< std::vector< process_handle_t > > _recipients;
+        /** @brief Free slots of _recipients. */
+        std::vector< u32_t > _free_recipients;
+        /** @brief Compact list of live process IDs. */
+        std::vector< size_t > _live;
+        /** @brief Position of each process in _live, indexed by ID. */
+        std::vector< size_t > _live_pos;
+        /** @brief Whether each slot holds a process spawned during the current run, indexed by ID. */
+        std::vector< bool > _transient;
+        /** @brief A process of the initial population retired during the current run. */
+        struct retired_t
+        {
+            process_ptr_t process;
+            world_key_t world;
+            size_t id;
+        };
+        /** @brief Processes retired during the current run, in retirement order. */
+        std::vector< retired_t > _retired_in_run;
+        /** @brief Whether the current run has started, set by step and cleared by init. */
+        bool _running;
+        /** @brief Live and active process IDs, the only ones scheduled, in increasing order when a step starts. */
+        std::vector< size_t > _active;
+        /** @brief Position of each process in _active, indexed by ID, npos if not listed. */
+        std::vector< size_t > _active_pos;
+        /** @brief Whether _active has been appended to or left with inactive entries since it was last sorted. */
+        bool _active_dirty;
+        /** @brief Whether the active processes are being scheduled, deactivated ones are then left in place. */
+        bool _scheduling;
+
+        /** @brief Type-erased cached view of a world, see get_view. */
+        struct view_t
+        {
+            /** @brief World version the view was built at, 0 if never built. */
+            u64_t version = 0;
+            /** @brief The std::vector< T * > of the view. */
+            std::shared_ptr< void > procs;
+        };
+        /** @brief Topology version of each world, bumped by spawns and retirements, indexed by world ID. */
+        std::vector< u64_t > _world_versions;
+        /** @brief Cached views, indexed by world ID then by process type. */
+        std::vector< std::unordered_map< std::type_index, view_t > > _views;
+
+        /** @brief Adds or removes a registered process from the active list, in O(1). */
+        void _set_process_active( const process_t *process, bool active );
+        /** @brief Drops inactive entries from the active list and sorts it by ID, if it changed. */
+        void _sort_active();
+
+        /** @brief Gets the ID of a world, interning the key if new. */
+        world_id_t _intern_world( const world_key_t &world );
+        /** @brief Resets the relative IDs of the processes of a world from a given ID on. */
+        void _renumber( const world_key_t &world, size_t from );
+
+        /** @brief Takes a free slot of _recipients, its list is empty. */
+        u32_t _acquire_recipients();
+        /** @brief Stamps the sender world of a message and hands it to the networks or the output channel. */
+        void _post( const std::shared_ptr< network::message_t > &msg );
+
+        /** @brief Undoes the spawns and retirements of the current run, see init. */
+        void _restore_population();
 
         /** @brief Updates _time to the minimum next update time. */
         void _update_time();
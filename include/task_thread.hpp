@@ -0,0 +1,130 @@
+/*
+ * File: task_thread.hpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This header file defines the task_thread_t class, a thread written as a chain of waits.
+ */
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include "network/message.hpp"
+#include "process.hpp"
+
+namespace isw
+{
+    /** @brief Function type resuming a task thread after a wait. */
+    using continuation_t = std::function< void( void ) >;
+
+    /**
+     * @brief Thread whose logic is a sequence of waits instead of a periodic fun().
+     * @details The logic starts in run() and each wait (sleep, wait_until, receive) takes the continuation to
+     * resume once it is over. The thread is scheduled exactly when its wait ends, a thread waiting for a message
+     * leaves the scheduler until one is delivered to its process, so it never polls. A continuation that returns
+     * without waiting again ends the task, which restarts from run() on init. Compute and sleep times are 0 and no
+     * noise is added.
+     */
+    class task_thread_t : public thread_t
+    {
+    public:
+        /**
+         * @brief Constructor.
+         * @param[in] th_time Time at which run() is called, defaults to 0.
+         */
+        task_thread_t( double th_time = 0.0 );
+        /**
+         * @brief Resumes the pending continuation, or waits again if no message has arrived yet.
+         */
+        void fun() override;
+        /**
+         * @brief Restarts the task from run() at the initial thread time.
+         */
+        void init() override;
+        /**
+         * @brief Checks whether the task has ended.
+         * @return True if the last continuation returned without waiting.
+         */
+        bool finished() const;
+
+    protected:
+        /**
+         * @brief Entry point of the task logic.
+         */
+        virtual void run() = 0;
+        /**
+         * @brief Waits for a duration.
+         * @param[in] dt Duration, from the current thread time.
+         * @param[in] next Continuation.
+         */
+        void sleep( double dt, continuation_t next );
+        /**
+         * @brief Waits until a given time.
+         * @param[in] time Resume time, past times resume at the current time.
+         * @param[in] next Continuation.
+         */
+        void wait_until( double time, continuation_t next );
+        /**
+         * @brief Waits for a message of a given type delivered to the process.
+         * @tparam T Message type, any type if network::message_t.
+         * @tparam F Callable taking a std::shared_ptr< T >.
+         * @param[in] next Continuation, called with the received message.
+         * @param[in] tag Required message tag, any tag if empty.
+         * @details Messages are received with receive_selective, messages of other types are set aside for the
+         * other threads of the process.
+         */
+        template< typename T = network::message_t, typename F >
+        void receive( F next, std::optional< size_t > tag = std::nullopt )
+        {
+            _receive = [this, next = std::move( next ), tag]()
+            {
+                auto msg = receive_selective< T >( tag );
+                if ( !msg )
+                    return false;
+                next( std::move( msg ) );
+                return true;
+            };
+            _await( wait_t::MESSAGE, nullptr );
+        }
+
+    private:
+        /** @brief What the task waits for. */
+        enum class wait_t
+        {
+            NONE,   /**< @brief Nothing, the task has ended. */
+            TIME,   /**< @brief The thread time. */
+            MESSAGE /**< @brief A message in the process input channel. */
+        };
+
+        /** @brief Registers the continuation of a wait. */
+        void _await( wait_t wait, continuation_t next );
+
+        /** @brief Current wait. */
+        wait_t _wait;
+        /** @brief Continuation resumed when the wait ends. */
+        continuation_t _next;
+        /** @brief Receive attempt of a message wait, resuming the task and returning true on success. */
+        std::function< bool( void ) > _receive;
+    };
+} // namespace isw
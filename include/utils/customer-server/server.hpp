@@ -42,6 +42,8 @@ namespace isw::cs {
     class server_t;
     template<class mes_type>
     class server_thread_t;
+    template<class mes_type, class Sorter>
+    class static_server_thread_t;
     /** @brief Function type mapping a database index to an initial value, used for server database initialization. */
     using fill = std::function<size_t(size_t)>;
     /**
@@ -76,9 +78,19 @@ namespace isw::cs {
 
             /**
              * @brief Initializes the server and populates the database using the init function.
+             * @details With an init image, the database is copied from the image instead, see set_init_image.
              */
             void init() override;
 
+            /**
+             * @brief Enables or disables the init image.
+             * @param[in] image True to record the database filled by the next init and copy it back on the
+             *   following ones without calling the init function, false to drop the image.
+             * @details Only meaningful for deterministic init functions: a random fill would be sampled once for
+             *   every replica.
+             */
+            void set_init_image(bool image);
+
             /**
              * @brief Factory method creating a fully configured server process with its thread (lvalue bindings).
              * @tparam mes_type The message type.
@@ -117,12 +129,44 @@ namespace isw::cs {
                     return res;
                 }
 
+            /**
+             * @brief Factory method creating a server process whose handler is inlined into its thread.
+             * @tparam mes_type The message type.
+             * @tparam Sorter Handler type, deduced, callable as void(thread_t &, std::shared_ptr<mes_type>).
+             * @param[in] db_size Number of items in the database.
+             * @param[in] init Initialization function for the database.
+             * @param[in] c_time Thread compute time.
+             * @param[in] sorter Handler of every incoming message, dispatching itself on the sender world
+             *   (msg->world_id, resolved with system_t::world_key).
+             * @param[in] compute Optional dynamic compute time setter.
+             * @param[in] sleep Optional dynamic sleep time setter.
+             * @param[in] s_time Thread sleep time, defaults to 0.
+             * @param[in] th_time Thread threshold time, defaults to 0.
+             * @param[in] name Process name, defaults to "default server".
+             * @return Shared pointer to the created server process.
+             */
+            template <class mes_type, class Sorter>
+            static std::shared_ptr<server_t> create_static_process(size_t db_size, fill init, 
+                double c_time, Sorter sorter, set compute = 0, set sleep = 0,
+                double s_time = 0, double th_time = 0, std::string name = "default server") {
+                    auto res = std::make_shared<server_t>(db_size, init, name);
+                    res->add_thread(std::make_shared<static_server_thread_t<mes_type, Sorter>>(c_time, 
+                        std::move(sorter), compute, sleep, s_time, th_time));
+                    return res;
+                }
+
             /** @brief Database of item quantities managed by this server. */
             std::vector<size_t> database;
         
         private:
             /** @brief Initialization function for populating the database. */
             fill _init;
+            /** @brief Whether init records and reuses an image of the database. */
+            bool _use_image;
+            /** @brief Whether _image holds a recorded database. */
+            bool _has_image;
+            /** @brief Database recorded by the first init with the image enabled. */
+            std::vector<size_t> _image;
     };
 
     /**
@@ -158,23 +202,19 @@ namespace isw::cs {
 
             /**
              * @brief Processes incoming messages and routes them through bindings.
-             * @details Receives a message, looks up the handler by world key, and invokes it.
+             * @details Receives a message, looks up the handler in a flat table indexed by the sender world ID,
+             *   and invokes it. The bindings map is only searched on the first message from each world.
              *   Throws std::runtime_error if no binding exists for the sender's world key.
              *   Optionally updates compute and sleep times via dynamic setters.
              */
             void fun() override {
                 std::shared_ptr< mes_type > msg;
                 if ((msg = receive_message< mes_type >()) != nullptr) {
-                    auto it = _bindings.find(msg->world_key);
-                    if (it != _bindings.end()) {
-                        auto& sorter = it->second;
-                        sorter(this->shared_from_this(), msg);
-                    }
-                    else {
-                        std::string err(" unknown sender world: ");
-                        err += msg->world_key;
-                        throw std::runtime_error(err);
-                    }
+                    const world_id_t id = msg->world_id;
+                    const sorter<mes_type> *handler = id < _dispatch.size() ? _dispatch[id] : nullptr;
+                    if (!handler)
+                        handler = _resolve(msg);
+                    (*handler)(this->shared_from_this(), msg);
                 };
                 if (_compute)
                     set_compute_time(_compute());
@@ -183,11 +223,98 @@ namespace isw::cs {
             }
 
         private:
+            /**
+             * @brief Finds the handler of a world not dispatched yet and caches it in the dispatch table.
+             * @param[in] msg The received message.
+             * @return Pointer to the handler.
+             * @throws std::runtime_error If there is no binding for the sender world.
+             */
+            const sorter<mes_type> *_resolve(const std::shared_ptr<mes_type> &msg) {
+                if (msg->world_id == no_world)
+                    throw std::runtime_error(" unknown sender world: message not sent through a system");
+                const world_key_t &key = get_process()->get_system()->world_key(msg->world_id);
+                auto it = _bindings.find(key);
+                if (it == _bindings.end()) {
+                    std::string err(" unknown sender world: ");
+                    err += key;
+                    throw std::runtime_error(err);
+                }
+                if (msg->world_id >= _dispatch.size())
+                    _dispatch.resize(msg->world_id + 1, nullptr);
+                _dispatch[msg->world_id] = &it->second;
+                return &it->second;
+            }
+
             /** @brief Message handler bindings mapping world keys to handler functions. */
             binding<mes_type> _bindings;
+            /** @brief Handlers indexed by world ID, filled on the first message from each world. */
+            std::vector<const sorter<mes_type> *> _dispatch;
+            /** @brief Dynamic compute time setter. */
+            /** @brief Dynamic sleep time setter. */
+            set _compute, _sleep;
+    };
+
+    /**
+     * @brief Server thread with its message handler as a template parameter.
+     * @tparam mes_type The message type (must extend network::message_t).
+     * @tparam Sorter Handler type, callable as void(thread_t &, std::shared_ptr<mes_type>).
+     * @details Same behaviour as server_thread_t, but a single handler receives every message and the call is
+     *   resolved at compile time, so lambdas inline into fun(). server_thread_t remains the type-erased fallback
+     *   for per-world bindings built at runtime.
+     */
+    template<class mes_type, class Sorter>
+    class static_server_thread_t : public thread_t {
+        public:
+            /**
+             * @brief Constructs a server thread.
+             * @param[in] c_time Compute time.
+             * @param[in] sorter Message handler.
+             * @param[in] compute Optional dynamic compute time setter.
+             * @param[in] sleep Optional dynamic sleep time setter.
+             * @param[in] s_time Sleep time, defaults to 0.
+             * @param[in] th_time Threshold time, defaults to 0.
+             */
+            static_server_thread_t(double c_time, Sorter sorter, set compute = 0, set sleep = 0,
+                double s_time = 0, double th_time = 0) : thread_t(c_time, s_time, th_time), 
+                _sorter(std::move(sorter)), _compute(compute), _sleep(sleep) {}
+
+            /**
+             * @brief Receives a message, if any, and passes it to the handler.
+             * @details Optionally updates compute and sleep times via dynamic setters.
+             */
+            void fun() override {
+                if (auto msg = receive_message< mes_type >())
+                    _sorter(static_cast<thread_t &>(*this), msg);
+                if (_compute)
+                    set_compute_time(_compute());
+                if (_sleep)
+                    set_sleep_time(_sleep());
+            }
+
+        private:
+            /** @brief Message handler. */
+            Sorter _sorter;
             /** @brief Dynamic compute time setter. */
             /** @brief Dynamic sleep time setter. */
             set _compute, _sleep;
     };
-}
 
+    /**
+     * @brief Creates a server thread with an inlined handler, deducing the handler type.
+     * @tparam mes_type The message type.
+     * @tparam Sorter Handler type, deduced.
+     * @param[in] c_time Compute time.
+     * @param[in] sorter Message handler, callable as void(thread_t &, std::shared_ptr<mes_type>).
+     * @param[in] compute Optional dynamic compute time setter.
+     * @param[in] sleep Optional dynamic sleep time setter.
+     * @param[in] s_time Sleep time, defaults to 0.
+     * @param[in] th_time Threshold time, defaults to 0.
+     * @return Shared pointer to the created thread.
+     */
+    template<class mes_type, class Sorter>
+    std::shared_ptr<static_server_thread_t<mes_type, Sorter>> make_server_thread(double c_time, Sorter sorter, 
+        set compute = 0, set sleep = 0, double s_time = 0, double th_time = 0) {
+            return std::make_shared<static_server_thread_t<mes_type, Sorter>>(c_time, std::move(sorter), 
+                compute, sleep, s_time, th_time);
+        }
+}
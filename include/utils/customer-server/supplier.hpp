@@ -29,6 +29,7 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <utility>
 #include "common.hpp"
 #include "process.hpp"
 #include "utils/customer-server/utils.hpp"
@@ -70,6 +71,19 @@ namespace isw::cs {
             static std::shared_ptr<supplier_t> create_process(double c_time, pick policy, 
                 ask item, ask quantity, world_key_t servers, set compute = 0, set sleep = 0, 
                 double s_time = 0, double th_time = 0, std::string name = "default server");
+
+            /**
+             * @brief Factory method creating a supplier process whose callbacks are inlined into its thread.
+             * @tparam Pick Server selection type, deduced, callable as size_t().
+             * @tparam Item Item selection type, deduced, callable as size_t(size_t).
+             * @tparam Quantity Quantity selection type, deduced, callable as size_t(size_t).
+             * @details Parameters are the same as create_process.
+             * @return Shared pointer to the created supplier process.
+             */
+            template <class Pick, class Item, class Quantity>
+            static std::shared_ptr<supplier_t> create_static_process(double c_time, Pick policy, 
+                Item item, Quantity quantity, world_key_t servers, set compute = 0, set sleep = 0, 
+                double s_time = 0, double th_time = 0, std::string name = "default server");
     };
 
     /**
@@ -114,4 +128,77 @@ namespace isw::cs {
             /** @brief Dynamic sleep time setter. */
             set _compute, _sleep;
     };
-}
\ No newline at end of file
+
+    /**
+     * @brief Supplier thread with its callbacks as template parameters.
+     * @tparam Pick Server selection type, callable as size_t().
+     * @tparam Item Item selection type, callable as size_t(size_t).
+     * @tparam Quantity Quantity selection type, callable as size_t(size_t).
+     * @details Same behaviour as supplier_thread_t, with the calls resolved at compile time so lambdas inline
+     *   into fun(). supplier_thread_t remains the type-erased fallback.
+     */
+    template <class Pick, class Item, class Quantity>
+    class static_supplier_thread_t : public thread_t {
+        public:
+            /**
+             * @brief Constructs a supplier thread.
+             * @details Parameters are the same as supplier_thread_t.
+             */
+            static_supplier_thread_t(double c_time, Pick policy, Item item, Quantity quantity, 
+                world_key_t servers, set compute = 0, set sleep = 0, 
+                double s_time = 0, double th_time = 0) : thread_t(c_time, s_time, th_time), 
+                _policy(std::move(policy)), _item(std::move(item)), _quantity(std::move(quantity)), 
+                _servers(servers), _compute(compute), _sleep(sleep) {}
+
+            /**
+             * @brief Generates and sends a restock request to a server.
+             */
+            void fun() override {
+                size_t choice = _policy();
+                cs::request_t send;
+                send.item = _item(choice);
+                send.quantity = _quantity(choice);
+                send_message(_servers, choice, send);
+                if (_compute)
+                    set_compute_time(_compute());
+                if (_sleep)
+                    set_sleep_time(_sleep());
+            }
+
+        private:
+            /** @brief Server selection policy. */
+            Pick _policy;
+            /** @brief Item selection function. */
+            Item _item;
+            /** @brief Quantity selection function. */
+            Quantity _quantity;
+            /** @brief World key of the target server group. */
+            world_key_t _servers;
+            /** @brief Dynamic compute time setter. */
+            /** @brief Dynamic sleep time setter. */
+            set _compute, _sleep;
+    };
+
+    /**
+     * @brief Creates a supplier thread with inlined callbacks, deducing their types.
+     * @details Parameters are the same as supplier_thread_t.
+     * @return Shared pointer to the created thread.
+     */
+    template <class Pick, class Item, class Quantity>
+    std::shared_ptr<static_supplier_thread_t<Pick, Item, Quantity>> make_supplier_thread(double c_time, 
+        Pick policy, Item item, Quantity quantity, world_key_t servers, set compute = 0, set sleep = 0, 
+        double s_time = 0, double th_time = 0) {
+            return std::make_shared<static_supplier_thread_t<Pick, Item, Quantity>>(c_time, std::move(policy), 
+                std::move(item), std::move(quantity), servers, compute, sleep, s_time, th_time);
+        }
+
+    template <class Pick, class Item, class Quantity>
+    std::shared_ptr<supplier_t> supplier_t::create_static_process(double c_time, Pick policy, Item item, 
+        Quantity quantity, world_key_t servers, set compute, set sleep, double s_time, double th_time, 
+        std::string name) {
+            auto res = std::make_shared<supplier_t>(name);
+            res->add_thread(make_supplier_thread(c_time, std::move(policy), std::move(item), 
+                std::move(quantity), servers, compute, sleep, s_time, th_time));
+            return res;
+        }
+}
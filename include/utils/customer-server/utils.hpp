@@ -34,14 +34,13 @@ namespace isw::cs {
 
     /**
      * @brief Message type for customer-server request passing.
-     * @details Extends network::message_t with fields to identify the requested item, tag, and quantity.
+     * @details Extends network::message_t with fields to identify the requested item and quantity. The message
+     *   tag identifies the type of request (e.g. buy, restock).
      */
     class request_t : public network::message_t {
         public:
             /** @brief Index of the requested item in the server database. */
             size_t item;
-            /** @brief Tag identifying the type of request (e.g. buy, restock). */
-            size_t tag;
             /** @brief Quantity to buy (negative) or restock (positive). */
             int  quantity;
     };
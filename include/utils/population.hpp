@@ -0,0 +1,198 @@
+/*
+ * File: population.hpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This header file defines the population_t process, running homogeneous entities through one batch kernel.
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+#include "process.hpp"
+
+namespace isw::utils {
+
+    class population_t;
+    /** @brief Function type updating every entity due at the current time, called once per batch. */
+    using kernel = std::function<void(population_t &, const std::vector<size_t> &)>;
+    /** @brief Function type mapping an entity index to the initial value of a column. */
+    using column_init = std::function<double(size_t)>;
+
+    /**
+     * @brief Process running N homogeneous entities with one kernel over structure of arrays state.
+     * @details Entity state lives in contiguous double columns instead of one object per entity. A single thread
+     *   wakes up at the earliest entity time and calls the kernel once with every entity due, so entities firing
+     *   at the same simulated time run as one batch, without per-entity virtual or std::function calls. After the
+     *   kernel, each due entity is rescheduled after the compute time plus its own sleep time. Unlike thread_t no
+     *   noise is added, so entities in step stay in the same batch. An entity time of infinity parks the entity.
+     *   Entity times are kept in a min-heap, so a batch costs O(k log N) for k due entities instead of a scan of
+     *   the whole population.
+     */
+    class population_t : public process_t {
+        public:
+            /**
+             * @brief Constructs a population.
+             * @param[in] size Number of entities.
+             * @param[in] batch_kernel Kernel called with the indices of the due entities.
+             * @param[in] c_time Compute time, common to every entity.
+             * @param[in] s_time Initial sleep time of every entity, defaults to 0.
+             * @param[in] th_time Initial time of every entity, defaults to 0.
+             * @param[in] name Process name, defaults to "default population".
+             */
+            population_t(size_t size, kernel batch_kernel, double c_time, double s_time = 0, 
+                double th_time = 0, std::string name = "default population");
+
+            /**
+             * @brief Factory method creating a population.
+             * @param[in] size Number of entities.
+             * @param[in] batch_kernel Kernel called with the indices of the due entities.
+             * @param[in] c_time Compute time, common to every entity.
+             * @param[in] s_time Initial sleep time of every entity, defaults to 0.
+             * @param[in] th_time Initial time of every entity, defaults to 0.
+             * @param[in] name Process name, defaults to "default population".
+             * @return Shared pointer to the created population.
+             */
+            static std::shared_ptr<population_t> create(size_t size, kernel batch_kernel, double c_time, 
+                double s_time = 0, double th_time = 0, std::string name = "default population");
+
+            /**
+             * @brief Adds a state column.
+             * @param[in] name Column name.
+             * @param[in] init Initial value of each entity, applied on init, defaults to 0.
+             * @return Index of the column.
+             */
+            size_t add_column(const std::string &name, column_init init = nullptr);
+
+            /**
+             * @brief Gets a column by index.
+             * @param[in] idx Column index.
+             * @return Reference to the column values, one per entity.
+             */
+            std::vector<double> &column(size_t idx);
+
+            /**
+             * @brief Gets a column by name.
+             * @param[in] name Column name.
+             * @return Reference to the column values, one per entity.
+             * @throws std::out_of_range If no column has this name.
+             */
+            std::vector<double> &column(const std::string &name);
+
+            /**
+             * @brief Returns the number of entities.
+             * @return Population size.
+             */
+            size_t size() const;
+
+            /**
+             * @brief Returns the next activation time of an entity.
+             * @param[in] idx Entity index.
+             * @return Entity time.
+             */
+            double get_entity_time(size_t idx) const;
+
+            /**
+             * @brief Sets the next activation time of an entity.
+             * @param[in] idx Entity index.
+             * @param[in] time New entity time, infinity to park the entity.
+             */
+            void set_entity_time(size_t idx, double time);
+
+            /**
+             * @brief Sets the sleep time of an entity, used from its next rescheduling.
+             * @param[in] idx Entity index.
+             * @param[in] s_time Sleep time.
+             */
+            void set_entity_sleep(size_t idx, double s_time);
+
+            /**
+             * @brief Returns the number of kernel calls in the current run.
+             * @return Batches executed.
+             */
+            size_t batches() const;
+
+            /**
+             * @brief Initializes the population, resetting entity times, sleep times and columns.
+             * @details The batch thread is added on the first call.
+             */
+            void init() override;
+
+        private:
+            class batch_thread_t;
+
+            /** @brief A scheduled entity activation, stale once the entity has been rescheduled. */
+            struct wakeup_t {
+                double time;
+                size_t idx;
+                size_t version;
+            };
+            /** @brief Heap ordering, earliest time first and lowest index among ties. */
+            struct later_t {
+                bool operator()(const wakeup_t &a, const wakeup_t &b) const {
+                    return a.time > b.time || (a.time == b.time && a.idx > b.idx);
+                }
+            };
+
+            /** @brief Runs the kernel on every entity due at the current time and reschedules them. */
+            void _run_batch(double current_time);
+            /** @brief Pushes the current time of an entity, invalidating its previous wake-up. */
+            void _schedule(size_t idx);
+            /** @brief Drops stale wake-ups from the top of the heap. */
+            void _skip_stale();
+            /** @brief Rebuilds the heap from the entity times. */
+            void _rebuild();
+
+            /** @brief Batch kernel. */
+            kernel _kernel;
+            /** @brief Compute time of every entity. */
+            double _c_time;
+            /** @brief Initial sleep time of every entity. */
+            double _initial_s_time;
+            /** @brief Initial time of every entity. */
+            double _initial_th_time;
+            /** @brief Next activation time of each entity. */
+            std::vector<double> _time;
+            /** @brief Wake-up version of each entity, bumped on every rescheduling. */
+            std::vector<size_t> _version;
+            /** @brief Pending wake-ups, at most one valid per entity. */
+            std::priority_queue<wakeup_t, std::vector<wakeup_t>, later_t> _wakeups;
+            /** @brief Sleep time of each entity. */
+            std::vector<double> _sleep;
+            /** @brief State columns. */
+            std::vector<std::vector<double>> _columns;
+            /** @brief Column names. */
+            std::vector<std::string> _names;
+            /** @brief Column initializers. */
+            std::vector<column_init> _inits;
+            /** @brief Indices of the due entities, reused across batches. */
+            std::vector<size_t> _due;
+            /** @brief Kernel calls in the current run. */
+            size_t _batches;
+            /** @brief Thread waking up at the earliest entity time. */
+            std::shared_ptr<batch_thread_t> _thread;
+    };
+}
@@ -39,6 +39,14 @@ namespace isw::uv
      */
     size_t count_collisions( const std::vector< std::shared_ptr< vehicle_t > > &vehicles, double coll_radius );
 
+    /**
+     * @brief Counts the number of pairwise collisions among vehicles.
+     * @param[in] vehicles Vector of vehicle raw pointers, e.g. a view from system_t::get_view.
+     * @param[in] coll_radius Distance threshold below which two vehicles are considered colliding.
+     * @return Number of unique vehicle pairs within collision radius.
+     */
+    size_t count_collisions( const std::vector< vehicle_t * > &vehicles, double coll_radius );
+
     /**
      * @brief Computes the Euclidean distance between two vehicles.
      * @param[in] v1 First vehicle.
@@ -46,4 +54,12 @@ namespace isw::uv
      * @return Euclidean distance between the two vehicles' position vectors.
      */
     double euclidean_distance( std::shared_ptr< vehicle_t > v1, std::shared_ptr< vehicle_t > v2 );
+
+    /**
+     * @brief Computes the Euclidean distance between two vehicles.
+     * @param[in] v1 First vehicle.
+     * @param[in] v2 Second vehicle.
+     * @return Euclidean distance between the two vehicles' position vectors.
+     */
+    double euclidean_distance( const vehicle_t &v1, const vehicle_t &v2 );
 } // namespace isw::uv
@@ -28,6 +28,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <utility>
 #include <vector>
 #include <functional>
 #include "process.hpp"
@@ -86,12 +87,33 @@ namespace isw::uv {
                 fill init_pos, fill init_vel, act policy, double th_time = 0, 
                 std::string name = "default vehicle");
 
+            /**
+             * @brief Factory method creating a vehicle process whose policy is inlined into its thread.
+             * @tparam Act Policy type, deduced, callable as void(thread_t &).
+             * @details Parameters are the same as create_process.
+             * @return Shared pointer to the created vehicle process.
+             */
+            template <class Act>
+            static std::shared_ptr<vehicle_t> create_static_process(size_t dimensions, double c_time, 
+                fill init_pos, fill init_vel, Act policy, double th_time = 0, 
+                std::string name = "default vehicle");
+
             /**
              * @brief Initializes the vehicle by populating position and velocity vectors.
-             * @details Calls process_t::init() then applies init_pos and init_vel to each dimension.
+             * @details Calls process_t::init() then applies init_pos and init_vel to each dimension, or copies
+             *   the init image if there is one, see set_init_image.
              */
             void init() override;
 
+            /**
+             * @brief Enables or disables the init image.
+             * @param[in] image True to record the position and velocity set by the next init and copy them back on
+             *   the following ones without calling init_pos and init_vel, false to drop the image.
+             * @details Only meaningful for deterministic init functions: random positions would be sampled once for
+             *   every replica.
+             */
+            void set_init_image(bool image);
+
             /** @brief Position vector, one entry per dimension. */
             std::vector<double> pos;
             /** @brief Velocity vector, one entry per dimension. */
@@ -102,6 +124,14 @@ namespace isw::uv {
             fill _init_pos;
             /** @brief Velocity initialization function. */
             fill _init_vel;
+            /** @brief Whether init records and reuses an image of position and velocity. */
+            bool _use_image;
+            /** @brief Whether _image_pos and _image_vel hold a recorded image. */
+            bool _has_image;
+            /** @brief Recorded initial position. */
+            std::vector<double> _image_pos;
+            /** @brief Recorded initial velocity. */
+            std::vector<double> _image_vel;
     };
 
     /**
@@ -127,4 +157,52 @@ namespace isw::uv {
             /** @brief Control policy function invoked each step. */
             act _policy;
     };
-}
\ No newline at end of file
+
+    /**
+     * @brief Vehicle thread with its policy as a template parameter.
+     * @tparam Act Policy type, callable as void(thread_t &).
+     * @details Same behaviour as uv_thread_t, with the call resolved at compile time so lambdas inline into
+     *   fun(). uv_thread_t remains the type-erased fallback.
+     */
+    template <class Act>
+    class static_uv_thread_t : public thread_t {
+        public:
+            /**
+             * @brief Constructs a vehicle thread with a control policy.
+             * @param[in] c_time Compute time.
+             * @param[in] policy Control policy.
+             * @param[in] th_time Threshold time, defaults to 0.
+             */
+            static_uv_thread_t(double c_time, Act policy, double th_time = 0) : 
+                thread_t(c_time, 0, th_time), _policy(std::move(policy)) {}
+
+            /**
+             * @brief Executes the vehicle's control policy.
+             */
+            void fun() override { _policy(static_cast<thread_t &>(*this)); }
+
+        private:
+            /** @brief Control policy invoked each step. */
+            Act _policy;
+    };
+
+    /**
+     * @brief Creates a vehicle thread with an inlined policy, deducing its type.
+     * @param[in] c_time Compute time.
+     * @param[in] policy Control policy, callable as void(thread_t &).
+     * @param[in] th_time Threshold time, defaults to 0.
+     * @return Shared pointer to the created thread.
+     */
+    template <class Act>
+    std::shared_ptr<static_uv_thread_t<Act>> make_uv_thread(double c_time, Act policy, double th_time = 0) {
+        return std::make_shared<static_uv_thread_t<Act>>(c_time, std::move(policy), th_time);
+    }
+
+    template <class Act>
+    std::shared_ptr<vehicle_t> vehicle_t::create_static_process(size_t dimensions, double c_time, 
+        fill init_pos, fill init_vel, Act policy, double th_time, std::string name) {
+            auto res = std::make_shared<vehicle_t>(dimensions, init_pos, init_vel, name);
+            res->add_thread(make_uv_thread(c_time, std::move(policy), th_time));
+            return res;
+        }
+}
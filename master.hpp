@@ -28,6 +28,7 @@
 #include "common.hpp"
 #include "global.hpp"
 #include "process.hpp"
+#include "task_thread.hpp"
 #include "system.hpp"
 #include "simulator.hpp"
 #include "random.hpp"
@@ -37,6 +38,7 @@
 #include "optimizer.hpp"
 
 // IO components
+#include "io/binary_logger.hpp"
 #include "io/input_parser.hpp"
 #include "io/logger.hpp"
 #include "io/output_writer.hpp"
@@ -44,3 +46,7 @@
 // Network components
 #include "network/message.hpp"
 #include "network/network.hpp"
+#include "network/latency_network.hpp"
+#include "network/pid_network.hpp"
+#include "network/pid_tuner.hpp"
+#include "network/value_network.hpp"
@@ -34,8 +34,11 @@ global_t::global_t() : _rand( std::make_shared< random_t >() ), _montecarlo_avg(
 
 void global_t::init()
 {
-    std::fill( _channel_in.begin(), _channel_in.end(), network::channel_t() );
-    std::fill( _channel_out.begin(), _channel_out.end(), network::channel_t() );
+    // emptied in place, channels keep their capacity and the next run does not allocate them again
+    for ( auto &channel : _channel_in )
+        channel.clear();
+    for ( auto &channel : _channel_out )
+        channel.clear();
     std::fill( _montecarlo_current.begin(), _montecarlo_current.end(), 0 );
     // altre cose da inizializzare?
 }
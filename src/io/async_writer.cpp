@@ -0,0 +1,104 @@
+/*
+ * File: async_writer.cpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This file implements the async_writer_t class methods for background file output.
+ */
+#include "io/async_writer.hpp"
+#include <chrono>
+
+using namespace isw;
+
+namespace
+{
+    /** @brief Maximum records concatenated into a single write. */
+    constexpr size_t batch_size = 1024;
+    /** @brief Writer thread back-off when the ring is empty. */
+    constexpr auto idle_wait = std::chrono::microseconds( 100 );
+} // namespace
+
+async_writer_t::async_writer_t( std::ofstream &&stream, size_t capacity, backpressure_t policy ) :
+    _ring( capacity ), _stream( std::move( stream ) ), _policy( policy ), _pushed( 0 ), _written( 0 ), _dropped( 0 ),
+    _stop( false )
+{
+    _worker = std::thread( &async_writer_t::_run, this );
+}
+
+async_writer_t::~async_writer_t()
+{
+    _stop.store( true, std::memory_order_release );
+    if ( _worker.joinable() )
+        _worker.join();
+}
+
+bool async_writer_t::push( std::string &&record )
+{
+    while ( !_ring.try_push( std::move( record ) ) )
+    {
+        if ( _policy == backpressure_t::DROP )
+        {
+            _dropped.fetch_add( 1, std::memory_order_relaxed );
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    _pushed++;
+    return true;
+}
+
+void async_writer_t::flush()
+{
+    while ( _written.load( std::memory_order_acquire ) != _pushed )
+        std::this_thread::yield();
+}
+
+size_t async_writer_t::dropped() const { return _dropped.load( std::memory_order_relaxed ); }
+
+void async_writer_t::_run()
+{
+    std::string batch, record;
+    while ( true )
+    {
+        // read the flag before draining so nothing pushed before the stop request is lost
+        const bool stop = _stop.load( std::memory_order_acquire );
+        size_t count = 0;
+        batch.clear();
+        while ( count < batch_size && _ring.try_pop( record ) )
+        {
+            batch += record;
+            count++;
+        }
+        if ( count > 0 )
+        {
+            _stream.write( batch.data(), batch.size() );
+            if ( _ring.empty() )
+                _stream.flush();
+            _written.fetch_add( count, std::memory_order_release );
+            continue;
+        }
+        if ( stop )
+            break;
+        std::this_thread::sleep_for( idle_wait );
+    }
+    _stream.flush();
+}
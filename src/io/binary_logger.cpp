@@ -0,0 +1,257 @@
+/*
+ * File: binary_logger.cpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This file implements the binary_logger_t class methods for columnar binary traces.
+ */
+#include "io/binary_logger.hpp"
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+using namespace isw;
+
+namespace
+{
+    constexpr char magic[8] = { 'I', 'S', 'W', 'T', 'R', 'A', 'C', 'E' };
+
+    template< typename T >
+    void write_raw( std::ofstream &stream, const T &value )
+    {
+        stream.write( reinterpret_cast< const char * >( &value ), sizeof( T ) );
+    }
+
+    template< typename T >
+    bool read_raw( std::ifstream &stream, T &value )
+    {
+        return static_cast< bool >( stream.read( reinterpret_cast< char * >( &value ), sizeof( T ) ) );
+    }
+} // namespace
+
+binary_logger_t::binary_logger_t( const std::filesystem::path &path, size_t block_rows ) :
+    _block( false ), _block_rows( block_rows ), _buffered( 0 ), _cursor( 0 ), _rows( 0 )
+{
+    if ( block_rows == 0 )
+    {
+        throw std::runtime_error( "Block size must be positive" );
+    }
+    _stream = std::ofstream( path, std::ios::binary | std::ios::trunc );
+    if ( !_stream.is_open() )
+    {
+        throw std::runtime_error( "Could not open log file" );
+    }
+}
+
+binary_logger_t::~binary_logger_t()
+{
+    if ( _block && _stream.is_open() )
+    {
+        _write_block();
+        _stream.close();
+    }
+}
+
+std::shared_ptr< binary_logger_t > binary_logger_t::create( const std::filesystem::path &path, size_t block_rows )
+{
+    return std::shared_ptr< binary_logger_t >( new binary_logger_t( path, block_rows ) );
+}
+
+std::shared_ptr< binary_logger_t > binary_logger_t::add_field( std::string_view field, field_type_t type )
+{
+    if ( _block )
+    {
+        throw std::runtime_error( "Fields modified after the scheme has been defined" );
+    }
+    _fields.push_back( std::string( field ) );
+    _types.push_back( type );
+    return shared_from_this();
+}
+
+std::shared_ptr< binary_logger_t > binary_logger_t::log_fields()
+{
+    if ( _block )
+    {
+        throw std::runtime_error( "Fields already logged" );
+    }
+    _stream.write( magic, sizeof( magic ) );
+    write_raw( _stream, version );
+    write_raw( _stream, static_cast< u32_t >( _fields.size() ) );
+    for ( size_t i = 0; i < _fields.size(); i++ )
+    {
+        write_raw( _stream, static_cast< u8_t >( _types[i] ) );
+        write_raw( _stream, static_cast< u32_t >( _fields[i].size() ) );
+        _stream.write( _fields[i].data(), _fields[i].size() );
+    }
+    _columns.assign( _fields.size() * _block_rows, 0 );
+    _block = true;
+    return shared_from_this();
+}
+
+u64_t &binary_logger_t::_next_slot()
+{
+    if ( !_block )
+    {
+        throw std::runtime_error( "Fields not logged yet" );
+    }
+    if ( _cursor >= _fields.size() )
+    {
+        throw std::runtime_error( "Log line does not fit the schema" );
+    }
+    return _columns[_cursor * _block_rows + _buffered];
+}
+
+std::shared_ptr< binary_logger_t > binary_logger_t::add_measurement( double value )
+{
+    auto &slot = _next_slot();
+    if ( _types[_cursor] == field_type_t::INTEGER )
+    {
+        // 2^63, the conversion is only defined for values truncating into [-2^63, 2^63)
+        constexpr double limit = 9223372036854775808.0;
+        if ( !( value >= -limit && value < limit ) )
+        {
+            throw std::runtime_error( "Measurement not representable in an integer column" );
+        }
+        int64_t converted = static_cast< int64_t >( value );
+        std::memcpy( &slot, &converted, sizeof( slot ) );
+    }
+    else
+        std::memcpy( &slot, &value, sizeof( slot ) );
+    _cursor++;
+    return shared_from_this();
+}
+
+std::shared_ptr< binary_logger_t > binary_logger_t::_add_integer( int64_t value )
+{
+    auto &slot = _next_slot();
+    if ( _types[_cursor] == field_type_t::REAL )
+    {
+        double converted = static_cast< double >( value );
+        std::memcpy( &slot, &converted, sizeof( slot ) );
+    }
+    else
+        std::memcpy( &slot, &value, sizeof( slot ) );
+    _cursor++;
+    return shared_from_this();
+}
+
+std::shared_ptr< binary_logger_t > binary_logger_t::log_measurement()
+{
+    if ( _cursor != _fields.size() )
+    {
+        _cursor = 0;
+        throw std::runtime_error( "Log line does not fit the schema" );
+    }
+    _cursor = 0;
+    _buffered++;
+    _rows++;
+    if ( _buffered == _block_rows )
+        _write_block();
+    return shared_from_this();
+}
+
+std::shared_ptr< binary_logger_t > binary_logger_t::flush()
+{
+    _write_block();
+    _stream.flush();
+    return shared_from_this();
+}
+
+size_t binary_logger_t::rows() const { return _rows; }
+
+void binary_logger_t::_write_block()
+{
+    if ( _buffered == 0 )
+        return;
+    write_raw( _stream, static_cast< u32_t >( _buffered ) );
+    for ( size_t c = 0; c < _fields.size(); c++ )
+        _stream.write( reinterpret_cast< const char * >( &_columns[c * _block_rows] ), _buffered * sizeof( u64_t ) );
+    _buffered = 0;
+}
+
+void binary_logger_t::to_csv( const std::filesystem::path &trace, const std::filesystem::path &csv )
+{
+    std::ifstream in( trace, std::ios::binary );
+    if ( !in.is_open() )
+    {
+        throw std::runtime_error( "Could not open trace file" );
+    }
+    std::ofstream out( csv );
+    if ( !out.is_open() )
+    {
+        throw std::runtime_error( "Could not open log file" );
+    }
+
+    char header[sizeof( magic )];
+    u32_t file_version, n_fields;
+    if ( !in.read( header, sizeof( header ) ) || std::memcmp( header, magic, sizeof( magic ) ) != 0 ||
+         !read_raw( in, file_version ) || file_version != version || !read_raw( in, n_fields ) )
+    {
+        throw std::runtime_error( "Malformed trace header" );
+    }
+
+    std::vector< field_type_t > types( n_fields );
+    for ( u32_t i = 0; i < n_fields; i++ )
+    {
+        u8_t type;
+        u32_t length;
+        if ( !read_raw( in, type ) || !read_raw( in, length ) )
+            throw std::runtime_error( "Malformed trace header" );
+        std::string name( length, '\0' );
+        if ( !in.read( name.data(), length ) )
+            throw std::runtime_error( "Malformed trace header" );
+        types[i] = static_cast< field_type_t >( type );
+        out << name << " ";
+    }
+    out << "\n";
+
+    out << std::setprecision( std::numeric_limits< double >::max_digits10 );
+    std::vector< u64_t > block;
+    u32_t n_rows;
+    while ( read_raw( in, n_rows ) )
+    {
+        block.resize( static_cast< size_t >( n_rows ) * n_fields );
+        if ( !in.read( reinterpret_cast< char * >( block.data() ), block.size() * sizeof( u64_t ) ) )
+            throw std::runtime_error( "Truncated trace block" );
+        for ( u32_t r = 0; r < n_rows; r++ )
+        {
+            for ( u32_t c = 0; c < n_fields; c++ )
+            {
+                const u64_t word = block[static_cast< size_t >( c ) * n_rows + r];
+                if ( types[c] == field_type_t::INTEGER )
+                {
+                    int64_t value;
+                    std::memcpy( &value, &word, sizeof( value ) );
+                    out << value << " ";
+                }
+                else
+                {
+                    double value;
+                    std::memcpy( &value, &word, sizeof( value ) );
+                    out << value << " ";
+                }
+            }
+            out << "\n";
+        }
+    }
+}
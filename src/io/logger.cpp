@@ -25,12 +25,245 @@
  *	This file implements the logger_t class methods for logging data to files.
  */
 #include "io/logger.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <numeric>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 using namespace isw;
 
+/**
+ * @brief Decides which records of a logger_t reach the file.
+ */
+class isw::sampler_t
+{
+public:
+    virtual ~sampler_t() = default;
+    /** @brief Returns the header written in place of the field names. */
+    virtual std::vector< std::string > header( const std::vector< std::string > &fields ) { return fields; }
+    /** @brief Consumes a record, returning the line to write now or nullptr. */
+    virtual const std::vector< std::string > *push( std::vector< std::string > &row ) = 0;
+    /** @brief Returns the lines still held by the sampler and resets it. */
+    virtual std::vector< std::vector< std::string > > drain() { return {}; }
+};
+
+namespace
+{
+    /** @brief Parses a measurement, NaN when it is not numeric. */
+    double parse( const std::string &value )
+    {
+        char *end = nullptr;
+        double parsed = std::strtod( value.c_str(), &end );
+        if ( value.empty() || end != value.c_str() + value.size() )
+            return std::numeric_limits< double >::quiet_NaN();
+        return parsed;
+    }
+
+    std::string format( double value )
+    {
+        char buffer[32];
+        auto [end, ec] = std::to_chars( buffer, buffer + sizeof( buffer ), value );
+        return std::string( buffer, end );
+    }
+
+    class every_sampler_t : public sampler_t
+    {
+    public:
+        every_sampler_t( size_t n ) : _n( n ), _seen( 0 ) {}
+        const std::vector< std::string > *push( std::vector< std::string > &row ) override
+        {
+            return _seen++ % _n == 0 ? &row : nullptr;
+        }
+
+    private:
+        size_t _n, _seen;
+    };
+
+    class change_sampler_t : public sampler_t
+    {
+    public:
+        change_sampler_t( double threshold, std::vector< std::string > watched ) :
+            _threshold( threshold ), _watched( std::move( watched ) )
+        {
+        }
+        std::vector< std::string > header( const std::vector< std::string > &fields ) override
+        {
+            _watched_idx.clear();
+            for ( auto &field : _watched )
+            {
+                auto it = std::find( fields.begin(), fields.end(), field );
+                if ( it == fields.end() )
+                {
+                    throw std::runtime_error( "Watched field not in the schema" );
+                }
+                _watched_idx.push_back( it - fields.begin() );
+            }
+            if ( _watched.empty() )
+            {
+                _watched_idx.resize( fields.size() );
+                std::iota( _watched_idx.begin(), _watched_idx.end(), 0 );
+            }
+            return fields;
+        }
+        const std::vector< std::string > *push( std::vector< std::string > &row ) override
+        {
+            if ( _last.empty() || _changed( row ) )
+            {
+                _last = row;
+                return &row;
+            }
+            return nullptr;
+        }
+
+    private:
+        bool _changed( const std::vector< std::string > &row ) const
+        {
+            for ( size_t i : _watched_idx )
+            {
+                double now = parse( row[i] ), before = parse( _last[i] );
+                if ( std::isnan( now ) || std::isnan( before ) )
+                {
+                    if ( row[i] != _last[i] )
+                        return true;
+                }
+                else if ( std::abs( now - before ) > _threshold )
+                    return true;
+            }
+            return false;
+        }
+
+        double _threshold;
+        std::vector< std::string > _watched;
+        std::vector< size_t > _watched_idx;
+        std::vector< std::string > _last;
+    };
+
+    class reservoir_sampler_t : public sampler_t
+    {
+    public:
+        reservoir_sampler_t( size_t k, std::shared_ptr< random_t > random ) : _k( k ), _seen( 0 ), _random( random ) {}
+        const std::vector< std::string > *push( std::vector< std::string > &row ) override
+        {
+            if ( _kept.size() < _k )
+                _kept.emplace_back( _seen, std::move( row ) );
+            else
+            {
+                std::uniform_int_distribution< size_t > dist( 0, _seen );
+                size_t j = dist( _random->get_engine() );
+                if ( j < _k )
+                    _kept[j] = { _seen, std::move( row ) };
+            }
+            _seen++;
+            return nullptr;
+        }
+        std::vector< std::vector< std::string > > drain() override
+        {
+            std::sort( _kept.begin(), _kept.end(),
+                       []( const auto &a, const auto &b ) { return a.first < b.first; } );
+            std::vector< std::vector< std::string > > rows;
+            for ( auto &kept : _kept )
+                rows.push_back( std::move( kept.second ) );
+            _kept.clear();
+            _seen = 0;
+            return rows;
+        }
+
+    private:
+        size_t _k, _seen;
+        std::shared_ptr< random_t > _random;
+        std::vector< std::pair< size_t, std::vector< std::string > > > _kept;
+    };
+
+    class bucket_sampler_t : public sampler_t
+    {
+    public:
+        bucket_sampler_t( std::string_view time_field, double window ) :
+            _time_field( time_field ), _window( window ), _rows( 0 )
+        {
+        }
+        std::vector< std::string > header( const std::vector< std::string > &fields ) override
+        {
+            auto it = std::find( fields.begin(), fields.end(), _time_field );
+            if ( it == fields.end() )
+            {
+                throw std::runtime_error( "Time field not in the schema" );
+            }
+            _time_idx = it - fields.begin();
+            _min.assign( fields.size(), 0 );
+            _max.assign( fields.size(), 0 );
+            _sum.assign( fields.size(), 0 );
+            std::vector< std::string > header{ _time_field };
+            for ( size_t i = 0; i < fields.size(); i++ )
+            {
+                if ( i == _time_idx )
+                    continue;
+                header.push_back( fields[i] + "_min" );
+                header.push_back( fields[i] + "_mean" );
+                header.push_back( fields[i] + "_max" );
+            }
+            return header;
+        }
+        const std::vector< std::string > *push( std::vector< std::string > &row ) override
+        {
+            double bucket = std::floor( parse( row[_time_idx] ) / _window );
+            const std::vector< std::string > *closed = nullptr;
+            if ( _rows > 0 && bucket != _bucket )
+            {
+                _close();
+                closed = &_line;
+            }
+            _bucket = bucket;
+            for ( size_t i = 0; i < row.size(); i++ )
+            {
+                if ( i == _time_idx )
+                    continue;
+                double value = parse( row[i] );
+                _min[i] = _rows == 0 ? value : std::min( _min[i], value );
+                _max[i] = _rows == 0 ? value : std::max( _max[i], value );
+                _sum[i] = _rows == 0 ? value : _sum[i] + value;
+            }
+            _rows++;
+            return closed;
+        }
+        std::vector< std::vector< std::string > > drain() override
+        {
+            if ( _rows == 0 )
+                return {};
+            _close();
+            return { _line };
+        }
+
+    private:
+        /** @brief Formats the current window into _line and starts a new one. */
+        void _close()
+        {
+            _line.clear();
+            _line.push_back( format( _bucket * _window ) );
+            for ( size_t i = 0; i < _sum.size(); i++ )
+            {
+                if ( i == _time_idx )
+                    continue;
+                _line.push_back( format( _min[i] ) );
+                _line.push_back( format( _sum[i] / _rows ) );
+                _line.push_back( format( _max[i] ) );
+            }
+            _rows = 0;
+        }
+
+        std::string _time_field;
+        double _window, _bucket;
+        size_t _time_idx, _rows;
+        std::vector< double > _min, _max, _sum;
+        std::vector< std::string > _line;
+    };
+} // namespace
+
 logger_t::logger_t( const std::filesystem::path &path ) : _block( false )
 {
     _stream = std::ofstream( path );
@@ -45,6 +278,8 @@ std::shared_ptr< logger_t > logger_t::create( const std::filesystem::path &path
     return std::shared_ptr< logger_t >( new logger_t( path ) );
 };
 
+logger_t::~logger_t() { _drain(); }
+
 std::shared_ptr< logger_t > logger_t::add_field( std::string_view field )
 {
     if ( _block )
@@ -63,12 +298,8 @@ std::shared_ptr< logger_t > logger_t::log_fields()
         throw std::runtime_error( "Fields already logged" );
         return shared_from_this();
     }
-    for ( const auto &field : _fields )
-    {
-        _stream << field << " ";
-    }
+    _emit( _sampler ? _sampler->header( _fields ) : _fields );
     _block = true;
-    _stream << std::endl;
     return shared_from_this();
 }
 
@@ -79,6 +310,12 @@ std::shared_ptr< logger_t > logger_t::add_measurement( std::string_view value )
     return shared_from_this();
 }
 
+std::shared_ptr< logger_t > logger_t::add_measurement( double value )
+{
+    _measurements.push_back( format( value ) );
+    return shared_from_this();
+}
+
 std::shared_ptr< logger_t > logger_t::log_measurement()
 {
     if ( _fields.size() != _measurements.size() )
@@ -87,11 +324,105 @@ std::shared_ptr< logger_t > logger_t::log_measurement()
         _measurements.clear();
         return shared_from_this();
     }
-    for ( const auto &measurement : _measurements )
+    if ( !_sampler )
+        _emit( _measurements );
+    else if ( auto row = _sampler->push( _measurements ) )
+        _emit( *row );
+    _measurements.clear();
+    return shared_from_this();
+}
+
+void logger_t::_emit( const std::vector< std::string > &row )
+{
+    std::string line;
+    for ( const auto &value : row )
     {
-        _stream << measurement << " ";
+        line += value;
+        line += " ";
     }
-    _stream << std::endl;
-    _measurements.clear();
+    _write_line( std::move( line ) );
+}
+
+void logger_t::_write_line( std::string &&line )
+{
+    if ( _async )
+    {
+        line += "\n";
+        _async->push( std::move( line ) );
+        return;
+    }
+    _stream << line << std::endl;
+}
+
+std::shared_ptr< logger_t > logger_t::set_async( size_t capacity, backpressure_t policy )
+{
+    if ( _async )
+    {
+        throw std::runtime_error( "Logger already asynchronous" );
+    }
+    _async = std::make_unique< async_writer_t >( std::move( _stream ), capacity, policy );
     return shared_from_this();
 }
+
+std::shared_ptr< logger_t > logger_t::flush()
+{
+    if ( _async )
+        _async->flush();
+    else
+        _stream.flush();
+    return shared_from_this();
+}
+
+size_t logger_t::dropped() const { return _async ? _async->dropped() : 0; }
+
+std::shared_ptr< logger_t > logger_t::_set_sampler( std::unique_ptr< sampler_t > sampler )
+{
+    if ( _block )
+    {
+        throw std::runtime_error( "Sampling mode changed after the scheme has been defined" );
+    }
+    _sampler = std::move( sampler );
+    return shared_from_this();
+}
+
+std::shared_ptr< logger_t > logger_t::sample_every( size_t n )
+{
+    if ( n == 0 )
+    {
+        throw std::runtime_error( "Decimation factor must be positive" );
+    }
+    return _set_sampler( std::make_unique< every_sampler_t >( n ) );
+}
+
+std::shared_ptr< logger_t > logger_t::sample_on_change( double threshold, std::vector< std::string > watched )
+{
+    return _set_sampler( std::make_unique< change_sampler_t >( threshold, std::move( watched ) ) );
+}
+
+std::shared_ptr< logger_t > logger_t::sample_reservoir( size_t k, std::shared_ptr< random_t > random )
+{
+    return _set_sampler( std::make_unique< reservoir_sampler_t >( k, random ) );
+}
+
+std::shared_ptr< logger_t > logger_t::sample_buckets( std::string_view time_field, double window )
+{
+    if ( !( window > 0 ) )
+    {
+        throw std::runtime_error( "Window must be positive" );
+    }
+    return _set_sampler( std::make_unique< bucket_sampler_t >( time_field, window ) );
+}
+
+std::shared_ptr< logger_t > logger_t::finish()
+{
+    _drain();
+    return shared_from_this();
+}
+
+void logger_t::_drain()
+{
+    if ( !_sampler || !_block )
+        return;
+    for ( auto &row : _sampler->drain() )
+        _emit( row );
+}
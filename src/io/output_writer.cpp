@@ -39,25 +39,70 @@ output_writer_t::output_writer_t( const std::filesystem::path path ) :
 }
 
 output_writer_t::~output_writer_t() {
+	if (_async) {
+		_handoff();
+		_async.reset();
+	}
 	if (_stream.is_open()) {
 		_stream.close();
 	}
 }
 
 void output_writer_t::write_line(const std::string& line) {
-	_stream << line << "\n";
+	_sink() << line << "\n";
+	if (_async)
+		_handoff();
+}
+
+void output_writer_t::set_async(size_t capacity, backpressure_t policy) {
+	if (_async)
+		throw std::runtime_error( "Writer already asynchronous" );
+	_stream.flush();
+	_pending.copyfmt(_stream);
+	_async = std::make_unique<async_writer_t>(std::move(_stream), capacity, policy);
+}
+
+void output_writer_t::flush() {
+	if (_async) {
+		_handoff();
+		_async->flush();
+	}
+	else
+		_stream.flush();
+}
+
+size_t output_writer_t::dropped() const {
+	return _async ? _async->dropped() : 0;
+}
+
+std::ostream& output_writer_t::_sink() {
+	if (_async)
+		return _pending;
+	return _stream;
+}
+
+void output_writer_t::_handoff() {
+	std::string record = _pending.str();
+	if (record.empty())
+		return;
+	_pending.str(std::string());
+	_async->push(std::move(record));
 }
 
 std::ofstream& output_writer_t::get_stream() {
+	if (_async)
+		throw std::runtime_error( "Stream owned by the asynchronous writer" );
 	return _stream;
 }
 
 output_writer_t& isw::operator<<(output_writer_t& writer, std::ostream& (*manip)(std::ostream&)) {
-    manip(writer.get_stream());
+    manip(writer._sink());
+    if (writer._async)
+        writer._handoff();
     return writer;
 }
 
 output_writer_t& isw::operator<<(output_writer_t& writer, std::ios_base& (*manip)(std::ios_base&)) {
-    manip(writer.get_stream());
+    manip(writer._sink());
     return writer;
 }
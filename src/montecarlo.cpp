@@ -29,18 +29,23 @@
 #include "simulator.hpp"
 using namespace isw;
 
-montecarlo_t::montecarlo_t( std::shared_ptr< simulator_t > sim ) : _sim( sim ) {}
+montecarlo_t::montecarlo_t( std::shared_ptr< simulator_t > sim ) : _sim( sim ), _reset_time( 0 ) {}
 
 std::shared_ptr< simulator_t > montecarlo_t::get_simulator() const { return _sim; }
 
+double montecarlo_t::get_reset_time() const { return _reset_time; }
+
 void montecarlo_t::run()
 {
-    auto global = _sim->get_system()->get_global();
+    auto system = _sim->get_system();
+    auto global = system->get_global();
     global->set_montecarlo_avg( 0.0 );
+    _reset_time = 0;
     double local_value;
     for ( size_t i = 0; i < global->montecarlo_budget(); i++ )
     {
         _sim->run();
+        _reset_time += ( system->get_reset_time() - _reset_time ) / static_cast< double >( i + 1 );
 
         for (size_t j = 0; j < global->get_montecarlo_variables(); j++) {
             local_value = global->get_montecarlo_avg(j) * ( i / static_cast< double >( i + 1 ) ) +
@@ -0,0 +1,172 @@
+/*
+ * File: latency_network.cpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This file implements the latency_network_t class for delay-based message delivery.
+ */
+#include "network/latency_network.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+using namespace isw;
+
+/**
+ * @brief Thread of a latency_network_t, scheduled exactly at the earliest pending delivery.
+ * @details Compute and sleep times are 0, the thread time is driven by the delivery heap (infinity when empty).
+ */
+class latency_network_t::delivery_thread_t : public thread_t
+{
+public:
+    delivery_thread_t( latency_network_t &network ) :
+        thread_t( 0, 0, std::numeric_limits< double >::infinity() ), _network( network )
+    {
+    }
+    void fun() override { _network._deliver( get_thread_time() ); }
+
+private:
+    latency_network_t &_network;
+};
+
+latency_network_t::latency_network_t( latency_fn default_latency ) :
+    _resolved_worlds( 0 ), _default_latency( default_latency ), _seq( 0 )
+{
+}
+
+std::shared_ptr< latency_network_t > latency_network_t::create( latency_fn default_latency )
+{
+    return std::make_shared< latency_network_t >( default_latency );
+}
+
+std::shared_ptr< latency_network_t > latency_network_t::set_latency( const world_key_t &from, const world_key_t &to,
+                                                                     latency_fn latency )
+{
+    _links[{ from, to }].latency = latency;
+    _resolved_worlds = 0;
+    return std::static_pointer_cast< latency_network_t >( shared_from_this() );
+}
+
+std::shared_ptr< latency_network_t > latency_network_t::set_bandwidth( const world_key_t &from,
+                                                                       const world_key_t &to, double bandwidth )
+{
+    _links[{ from, to }].bandwidth = bandwidth;
+    _resolved_worlds = 0;
+    return std::static_pointer_cast< latency_network_t >( shared_from_this() );
+}
+
+void latency_network_t::init()
+{
+    if ( !_thread )
+    {
+        _thread = std::make_shared< delivery_thread_t >( *this );
+        add_thread( _thread );
+    }
+    process_t::init();
+    _heap = {};
+    for ( auto &[key, link] : _links )
+        link.busy_until = 0;
+    _seq = 0;
+    _resolve_links();
+}
+
+void latency_network_t::_resolve_links()
+{
+    auto system = get_system();
+    _routes.clear();
+    for ( auto &[key, link] : _links )
+    {
+        world_id_t from, to;
+        try
+        {
+            from = system->world_id( key.first );
+            to = system->world_id( key.second );
+        }
+        catch ( const std::out_of_range & )
+        {
+            continue; // no process in one of the worlds yet
+        }
+        _routes[static_cast< u64_t >( from ) << 32 | to] = &link;
+    }
+    _resolved_worlds = system->total_worlds();
+}
+
+bool latency_network_t::on_send( const std::shared_ptr< network::message_t > &msg )
+{
+    if ( !_thread )
+        throw std::logic_error( "latency network not initialized" );
+    auto system = get_system();
+    const double now = system->get_current_time();
+    const auto &processes = system->get_processes();
+    if ( _resolved_worlds != system->total_worlds() )
+        _resolve_links();
+
+    if ( msg->receiver != network::multicast_receiver )
+    {
+        if ( msg->receiver >= processes.size() )
+            throw std::out_of_range( "receiver ID out of range" );
+        _schedule( msg, { msg->receiver, msg->receiver_generation }, processes[msg->receiver].get(), now );
+        return true;
+    }
+    for ( auto to : system->recipients( *msg ) )
+        _schedule( msg, to, processes[to.id].get(), now );
+    system->release_recipients( *msg );
+    return true;
+}
+
+void latency_network_t::_schedule( const std::shared_ptr< network::message_t > &msg, process_handle_t to,
+                                   const process_t *receiver, double now )
+{
+    double start = now;
+    latency_fn latency = _default_latency;
+    auto it = receiver ? _routes.find( static_cast< u64_t >( msg->world_id ) << 32 | receiver->get_world_id().value() )
+                       : _routes.end();
+    if ( it != _routes.end() )
+    {
+        auto &link = *it->second;
+        if ( link.latency )
+            latency = link.latency;
+        if ( link.bandwidth > 0 )
+        {
+            start = std::max( now, link.busy_until ) + 1 / link.bandwidth;
+            link.busy_until = start;
+        }
+    }
+    const double time = start + ( latency ? std::max( 0.0, latency() ) : 0.0 );
+
+    _heap.push( { time, _seq++, msg, to } );
+    if ( time < _thread->get_thread_time() )
+        _thread->set_thread_time( time );
+}
+
+void latency_network_t::_deliver( double current_time )
+{
+    auto system = get_system();
+    while ( !_heap.empty() && _heap.top().time <= current_time )
+    {
+        system->deliver( _heap.top().msg, _heap.top().to );
+        _heap.pop();
+    }
+    _thread->set_thread_time( _heap.empty() ? std::numeric_limits< double >::infinity() : _heap.top().time );
+}
+
+size_t latency_network_t::in_flight() const { return _heap.size(); }
@@ -26,46 +26,137 @@
  */
 #include "network/network.hpp"
 #include <algorithm>
+#include <random>
 #include "process.hpp"
 using namespace isw;
 
-scanner_t::scanner_t( double c_time, double s_time, double th_time ) : thread_t( c_time, s_time, th_time ) {}
+bool network_t::on_send( const std::shared_ptr< network::message_t > & /*msg*/ ) { return false; }
+
+void network_t::on_spawn( size_t id )
+{
+    for ( auto &thread : get_threads() )
+        if ( auto scanner = std::dynamic_pointer_cast< scanner_t >( thread ); scanner && scanner->owns( id ) )
+            scanner->register_id( id );
+}
+
+void network_t::on_retire( size_t id )
+{
+    for ( auto &thread : get_threads() )
+        if ( auto scanner = std::dynamic_pointer_cast< scanner_t >( thread ) )
+            scanner->unregister_id( id );
+}
+
+scanner_t::scanner_t( double c_time, double s_time, double th_time ) :
+    thread_t( c_time, s_time, th_time ), _current( 0 ), _seen( 0 )
+{
+}
 
 void scanner_t::init()
 {
     thread_t::init();
+    _rebuild();
+}
 
-    auto system = get_process()->get_system();
-    auto &processes = system->get_processes();
+void scanner_t::_rebuild()
+{
+    auto &processes = get_process()->get_system()->get_processes();
 
     // rebuild scanner
     _scanner.clear();
+    _position.assign( processes.size(), npos );
     for ( size_t i = 0; i < processes.size(); i++ )
-        _scanner.push_back( i );
+        if ( processes[i] && owns( i ) )
+        {
+            _position[i] = _scanner.size();
+            _scanner.push_back( i );
+        }
+    _seen = processes.size();
     // Temporary workaround; consider refactoring for production quality
-    _current = processes.size();
+    _current = _scanner.size();
 }
 
-void scanner_t::fun()
+void scanner_t::_swap( size_t i, size_t j )
 {
-    auto system = get_process()->get_system();
-    auto &processes = system->get_processes();
-    if ( processes.size() != _scanner.size() )
+    std::swap( _scanner[i], _scanner[j] );
+    _position[_scanner[i]] = i;
+    _position[_scanner[j]] = j;
+}
+
+void scanner_t::register_id( size_t id )
+{
+    if ( id >= _position.size() )
+        _position.resize( id + 1, npos );
+    if ( _position[id] != npos )
+        return;
+
+    const bool round_over = _current >= _scanner.size();
+    _position[id] = _scanner.size();
+    _scanner.push_back( id );
+    if ( round_over )
     {
-        // // rebuild scanner
-        // _scanner.clear();
-        // for ( size_t i = 0; i < processes.size(); i++ )
-        //     _scanner.push_back( i );
+        _current = _scanner.size();
+        return;
+    }
+    auto random = get_process()->get_system()->get_global()->get_random();
+    std::uniform_int_distribution< size_t > dist( _current, _scanner.size() - 1 );
+    _swap( dist( random->get_engine() ), _scanner.size() - 1 );
+}
 
-        // _current = processes.size();
-        init();
+void scanner_t::unregister_id( size_t id )
+{
+    if ( id >= _position.size() || _position[id] == npos )
+        return;
+
+    const size_t last = _scanner.size() - 1;
+    size_t pos = _position[id];
+    if ( pos < _current && _current <= last )
+    {
+        // move the hole to the end of the visited region, then fill it with the last unvisited process
+        _swap( pos, _current - 1 );
+        pos = _current - 1;
+        _current--;
     }
+    _swap( pos, last );
+    _scanner.pop_back();
+    _position[id] = npos;
+    if ( _current > _scanner.size() )
+        _current = _scanner.size();
+}
+
+void scanner_t::_on_topology_change()
+{
+    auto &processes = get_process()->get_system()->get_processes();
+    if ( processes.size() < _seen )
+    {
+        _rebuild();
+        return;
+    }
+    for ( size_t id = _seen; id < processes.size(); id++ )
+        if ( processes[id] && owns( id ) )
+            register_id( id );
+    _seen = processes.size();
+}
+
+bool scanner_t::owns( size_t /*id*/ ) const { return true; }
+
+void scanner_t::fun() { _scan_one(); }
+
+bool scanner_t::_scan_one()
+{
+    auto system = get_process()->get_system();
+    auto &processes = system->get_processes();
+    if ( processes.size() != _seen )
+        _on_topology_change();
+    if ( _scanner.empty() )
+        return false;
 
     auto global = system->get_global();
     if ( _current >= _scanner.size() )
     {
         auto random = global->get_random();
         std::shuffle( _scanner.begin(), _scanner.end(), random->get_engine() );
+        for ( size_t i = 0; i < _scanner.size(); i++ )
+            _position[_scanner[i]] = i;
         _current = 0;
 
         on_start_scan();
@@ -76,17 +167,72 @@ void scanner_t::fun()
 
     auto &current_channel = global->get_channel_out()[sched];
     if ( current_channel.empty() || filter( current_channel ) )
-        return;
+        return false;
 
     auto msg = current_channel.front();
     current_channel.pop();
+    system->on_dequeue( sched );
 
 
     assert( msg->sender == sched ); // actually sending to the right one
 
-    global->get_channel_in()[msg->receiver].push( msg );
+    system->deliver( msg );
+    return true;
 }
 
 void scanner_t::on_start_scan() {}
 
 bool scanner_t::filter( network::channel_t & /*current_channel*/ ) { return false; }
+
+batch_scanner_t::batch_scanner_t( size_t batch, double c_time, double s_time, double th_time ) :
+    scanner_t( c_time, s_time, th_time ), _batch( batch ), _forwarded( 0 ), _saved_steps( 0 )
+{
+}
+
+void batch_scanner_t::init()
+{
+    scanner_t::init();
+    _forwarded = 0;
+    _saved_steps = 0;
+}
+
+void batch_scanner_t::fun()
+{
+    // stop when the batch is full or when a whole round has been visited without forwarding anything,
+    // a streak of idle visits ending a round and at least as long as the round covers every process
+    size_t moved = 0, idle = 0;
+    do
+    {
+        if ( _scan_one() )
+        {
+            moved++;
+            idle = 0;
+        }
+        else
+            idle++;
+    }
+    while ( ( _batch == 0 || moved < _batch ) && !( _current >= _scanner.size() && idle >= _scanner.size() ) );
+
+    _forwarded += moved;
+    if ( moved > 1 )
+        _saved_steps += moved - 1;
+}
+
+size_t batch_scanner_t::saved_steps() const { return _saved_steps; }
+
+size_t batch_scanner_t::forwarded() const { return _forwarded; }
+
+shard_scanner_t::shard_scanner_t( size_t shard, size_t shards, shard_mode_t mode, double c_time, double s_time,
+                                  double th_time ) :
+    scanner_t( c_time, s_time, th_time ), _shard( shard ), _shards( shards ), _mode( mode )
+{
+    assert( shard < shards );
+}
+
+bool shard_scanner_t::owns( size_t id ) const
+{
+    if ( _mode == shard_mode_t::HASH )
+        return id % _shards == _shard;
+    auto &process = get_process()->get_system()->get_processes()[id];
+    return process->get_world_id().value() % _shards == _shard;
+}
@@ -26,35 +26,38 @@
  */
 #include "network/pid_network.hpp"
 #include <algorithm>
+#include <stdexcept>
 using namespace isw;
 
-pid_scanner_t::pid_scanner_t(double obj_occupancy, double th_time, double error_threshold) : 
-    scanner_t(0.2, S_TIME_MIN, th_time), _obj_occupancy(obj_occupancy), _integral(0), 
-    _prev_error(0), _prev_dv(0), _last_time(0), _error_threshold(error_threshold) {}
+pid_scanner_t::pid_scanner_t(double obj_occupancy, double th_time, double error_threshold, pid_gains_t gains) : 
+    scanner_t(0.2, gains.s_time_min, th_time), _gains(gains), _obj_occupancy(obj_occupancy), _integral(0), 
+    _prev_error(0), _prev_dv(0), _last_time(0), _error_threshold(error_threshold), _abs_error_sum(0),
+    _samples(0) {}
 
 void pid_scanner_t::on_start_scan() {
     if (get_thread_time() == 0) return;
-    auto gl = get_global();
-    auto queues = gl->get_channel_out();
-    double measurement = 0;
-    for (auto &c : queues) 
-        measurement += static_cast<double>(c.size()) / queues.size();
+    auto system = get_process()->get_system();
+    const size_t n_processes = system->live_processes().size();
+    double measurement = n_processes == 0 ? 0 :
+        static_cast<double>(system->outstanding_messages()) / n_processes;
     double error = measurement - _obj_occupancy;
+    _abs_error_sum += std::abs(error);
+    _samples++;
     double dt = get_thread_time() - _last_time;
     double dv = (error - _prev_error) / dt; //update last time
-    double smooth_dv = (1 - DV_ALPHA) * _prev_dv + DV_ALPHA * dv;
-    double control_1 = KP * error + KD * smooth_dv;
+    double smooth_dv = (1 - _gains.dv_alpha) * _prev_dv + _gains.dv_alpha * dv;
+    double control_1 = _gains.kp * error + _gains.kd * smooth_dv;
     if (std::abs(error) < _error_threshold) _integral = 0.0;
     else {
         double try_integral = _integral + error * dt;
-        double try_control = control_1 + try_integral * KI;
+        double try_control = control_1 + try_integral * _gains.ki;
         double try_sleep = get_sleep_time() - try_control;
-        if (try_sleep > S_TIME_MIN && try_sleep < S_TIME_MAX)
+        if (try_sleep > _gains.s_time_min && try_sleep < _gains.s_time_max)
             _integral = try_integral;
     }
-    double control = control_1 + _integral * KI;
+    double control = control_1 + _integral * _gains.ki;
     set_sleep_time(std::clamp( get_sleep_time() - control, 
-        S_TIME_MIN, S_TIME_MAX));
+        _gains.s_time_min, _gains.s_time_max));
     _prev_error = error;
     _prev_dv = smooth_dv;
     _last_time = get_thread_time();
@@ -66,5 +69,15 @@ void pid_scanner_t::init() {
     _prev_error = 0;
     _prev_dv = 0;
     _last_time = 0;
-    set_sleep_time(S_TIME_MIN);
-}
\ No newline at end of file
+    _abs_error_sum = 0;
+    _samples = 0;
+    set_sleep_time(_gains.s_time_min);
+}
+
+void pid_scanner_t::set_gains(const pid_gains_t &gains) { _gains = gains; }
+
+const pid_gains_t &pid_scanner_t::get_gains() const { return _gains; }
+
+double pid_scanner_t::mean_abs_error() const {
+    return _samples == 0 ? 0 : _abs_error_sum / _samples;
+}
@@ -0,0 +1,84 @@
+/*
+ * File: pid_tuner.cpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This file implements the pid_tuner_t optimizer for pid_scanner_t gains.
+ */
+#include "network/pid_tuner.hpp"
+#include <stdexcept>
+using namespace isw;
+
+pid_tuner_t::pid_tuner_t(std::shared_ptr<simulator_t> sim, size_t runs) :
+    optimizer_t<double>(sim->get_system()->get_global()), _sim(sim), _runs(runs), _best_error(0) {
+        if (_runs == 0)
+            throw std::runtime_error("pid_tuner_t needs at least one run per candidate");
+        for (auto &net : _sim->get_system()->get_networks())
+            for (auto &thread : net->get_threads())
+                if (auto scanner = std::dynamic_pointer_cast<pid_scanner_t>(thread))
+                    _scanners.push_back(scanner);
+        if (_scanners.empty())
+            throw std::runtime_error("no pid_scanner_t to tune");
+    }
+
+pid_gains_t pid_tuner_t::_gains_of(const std::vector<double> &arguments) const {
+    pid_gains_t gains = _base;
+    gains.kp = arguments[0];
+    gains.ki = arguments[1];
+    gains.kd = arguments[2];
+    return gains;
+}
+
+double pid_tuner_t::obj_fun(std::vector<double> &arguments) {
+    const pid_gains_t gains = _gains_of(arguments);
+    for (auto &scanner : _scanners)
+        scanner->set_gains(gains);
+    double error = 0;
+    for (size_t i = 0; i < _runs; i++) {
+        _sim->run();
+        for (auto &scanner : _scanners)
+            error += scanner->mean_abs_error();
+    }
+    return error / (_runs * _scanners.size());
+}
+
+pid_gains_t pid_tuner_t::tune(const pid_gains_t &min, const pid_gains_t &max) {
+    auto global = get_global();
+    if (global->optimizer_budget() == 0)
+        throw std::runtime_error("no optimizer budget to tune with");
+
+    // optimize reports through the global, which may hold the result of another optimizer
+    const double result = global->get_optimizer_result();
+    const std::vector<double> parameters = global->get_optimizer_optimal_parameters();
+    _base = min;
+    optimize(optimizer_strategy::MINIMIZE, {min.kp, min.ki, min.kd}, {max.kp, max.ki, max.kd});
+    const pid_gains_t best = _gains_of(global->get_optimizer_optimal_parameters());
+    _best_error = global->get_optimizer_result();
+    global->set_optimizer_result(result);
+    global->set_optimizer_optimal_parameters(parameters);
+
+    for (auto &scanner : _scanners)
+        scanner->set_gains(best);
+    return best;
+}
+
+double pid_tuner_t::get_best_error() const { return _best_error; }
@@ -27,40 +27,226 @@
 #include "process.hpp"
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <optional>
 #include "common.hpp"
 #include "system.hpp"
 using namespace isw;
 
-process_t::process_t( std::string name ) : _id( std::nullopt ), _name( name ), _is_active( true ) {}
+process_t::process_t( std::string name ) :
+    _id( std::nullopt ), _name( name ), _is_active( true ), _threads_dirty( false ), _scheduling( false ),
+    _aside_count( 0 ), _aside_seq( 0 )
+{
+}
 
 void process_t::init()
 {
+    _aside.clear();
+    _free_aside.clear();
+    _aside_all = {};
+    for ( auto &[type, queue] : _aside_by_type )
+        queue = {};
+    for ( auto &[type, tags] : _aside_by_tag )
+        for ( auto &[tag, queue] : tags )
+            queue = {};
+    _aside_count = 0;
+    _parked.clear();
     for ( auto &thread : this->_threads )
     {
+        thread->_parked = false;
         thread->init();
+        thread->_is_active = true;
+        _set_thread_active( thread.get(), true );
     }
 };
 
 
 void process_t::schedule( double current_time )
 {
-    assert( _system.get() != nullptr ); // ENSURE THIS PROCESS IS ASSOCIATED TO A SYSTEM
-    auto random = _system->get_global()->get_random();
+    assert( !_system.expired() ); // ENSURE THIS PROCESS IS ASSOCIATED TO A SYSTEM
+    // the process and its threads must outlive the loop even if a thread retires the process
+    const auto self = shared_from_this();
     // auto shuffled = _threads;
     // std::shuffle( shuffled.begin(), shuffled.end(), random->get_engine() );
-    for ( auto &thread : _threads )
-        thread->schedule( current_time );
+    // threads may (de)activate others while being scheduled: the ones activated now wait for the next step, the
+    // deactivated ones stay in the list until the loop is over
+    _sort_threads();
+    _scheduling = true;
+    const size_t listed = _active_threads.size();
+    for ( size_t pos = 0; pos < listed; pos++ )
+        if ( _active_threads[pos]->_listed )
+            _active_threads[pos]->schedule( current_time );
+    _scheduling = false;
+    _sort_threads();
+}
+
+void process_t::_set_thread_active( thread_t *thread, bool active )
+{
+    if ( thread->_listed == active )
+        return;
+    thread->_listed = active;
+    _threads_dirty = true;
+    if ( active )
+    {
+        // still there if unlisted during the current schedule
+        if ( thread->_active_pos == npos )
+        {
+            thread->_active_pos = _active_threads.size();
+            _active_threads.push_back( thread );
+        }
+        return;
+    }
+    // the schedule is iterating the list, the entry is dropped by _sort_threads once it is over
+    if ( _scheduling )
+        return;
+    const size_t pos = thread->_active_pos;
+    _active_threads[pos] = _active_threads.back();
+    _active_threads[pos]->_active_pos = pos;
+    _active_threads.pop_back();
+    thread->_active_pos = npos;
+}
+
+void process_t::_sort_threads()
+{
+    if ( !_threads_dirty )
+        return;
+    auto unlisted = []( thread_t *thread )
+    {
+        if ( thread->_listed )
+            return false;
+        thread->_active_pos = npos;
+        return true;
+    };
+    _active_threads.erase( std::remove_if( _active_threads.begin(), _active_threads.end(), unlisted ),
+                           _active_threads.end() );
+    // insertion order, whatever the history of (de)activations and parkings
+    std::sort( _active_threads.begin(), _active_threads.end(),
+               []( const thread_t *a, const thread_t *b ) { return a->_order < b->_order; } );
+    for ( size_t pos = 0; pos < _active_threads.size(); pos++ )
+        _active_threads[pos]->_active_pos = pos;
+    _threads_dirty = false;
+}
+
+void process_t::_park( thread_t *thread )
+{
+    if ( !thread->_parked )
+    {
+        thread->_parked = true;
+        _parked.push_back( thread );
+    }
+    _set_thread_active( thread, false );
+    thread->_th_time = std::numeric_limits< double >::infinity();
+}
+
+void process_t::notify_delivery( double time )
+{
+    if ( _parked.empty() )
+        return;
+    for ( auto thread : _parked )
+    {
+        thread->_parked = false;
+        // reactivated in the meantime, already scheduled
+        if ( !thread->_is_active || thread->_listed )
+            continue;
+        thread->_th_time = time;
+        _set_thread_active( thread, true );
+    }
+    _parked.clear();
+}
+
+void process_t::_set_aside( std::shared_ptr< network::message_t > msg )
+{
+    const std::type_index type( typeid( *msg ) );
+    const size_t tag = msg->tag;
+    size_t slot;
+    if ( _free_aside.empty() )
+    {
+        slot = _aside.size();
+        _aside.emplace_back();
+    }
+    else
+    {
+        slot = _free_aside.back();
+        _free_aside.pop_back();
+    }
+    _aside[slot] = { _aside_seq, std::move( msg ) };
+    for ( auto queue : { &_aside_all, &_aside_by_type[type], &_aside_by_tag[type][tag] } )
+    {
+        queue->refs.push_back( { slot, _aside_seq } );
+        queue->live++;
+    }
+    _aside_seq++;
+    _aside_count++;
+}
+
+void process_t::_trim( aside_queue_t &queue )
+{
+    auto stale = [this]( const aside_ref_t &ref ) { return !_aside[ref.slot].msg || _aside[ref.slot].seq != ref.seq; };
+    while ( !queue.refs.empty() && stale( queue.refs.front() ) )
+        queue.refs.pop_front();
+    // taken through another queue, behind a message still waiting
+    if ( queue.refs.size() > 2 * queue.live + 16 )
+        queue.refs.erase( std::remove_if( queue.refs.begin(), queue.refs.end(), stale ), queue.refs.end() );
+}
+
+std::shared_ptr< network::message_t > process_t::_take_aside( const std::type_index *type,
+                                                              std::optional< size_t > tag )
+{
+    if ( _aside_count == 0 )
+        return nullptr;
+    aside_queue_t *queue = nullptr;
+    if ( type && tag )
+    {
+        auto tags = _aside_by_tag.find( *type );
+        if ( tags != _aside_by_tag.end() )
+        {
+            auto it = tags->second.find( *tag );
+            if ( it != tags->second.end() )
+                queue = &it->second;
+        }
+    }
+    else if ( type )
+    {
+        auto it = _aside_by_type.find( *type );
+        if ( it != _aside_by_type.end() )
+            queue = &it->second;
+    }
+    else if ( !tag )
+        queue = &_aside_all;
+    else // oldest front among the types
+        for ( auto &[key, tags] : _aside_by_tag )
+        {
+            auto it = tags.find( *tag );
+            if ( it == tags.end() || it->second.live == 0 )
+                continue;
+            if ( !queue || it->second.refs.front().seq < queue->refs.front().seq )
+                queue = &it->second;
+        }
+    if ( !queue || queue->live == 0 )
+        return nullptr;
+
+    auto &entry = _aside[queue->refs.front().slot];
+    auto msg = std::move( entry.msg );
+    _free_aside.push_back( queue->refs.front().slot );
+    _aside_count--;
+    const std::type_index msg_type( typeid( *msg ) );
+    for ( auto listed : { &_aside_all, &_aside_by_type[msg_type], &_aside_by_tag[msg_type][msg->tag] } )
+    {
+        listed->live--;
+        _trim( *listed );
+    }
+    return msg;
 }
 
-std::shared_ptr< system_t > process_t::get_system() const { return _system; }
+std::shared_ptr< system_t > process_t::get_system() const { return _system.lock(); }
 
 double process_t::next_update_time() const
 {
-    auto it = std::min_element( _threads.begin(), _threads.end(), []( const auto &a, const auto &b )
+    auto it = std::min_element( _active_threads.begin(), _active_threads.end(), []( const auto &a, const auto &b )
                                 { return a->get_thread_time() < b->get_thread_time(); } );
-    if ( it != _threads.end() )
+    if ( it != _active_threads.end() )
     {
         return ( *it )->get_thread_time();
     }
@@ -69,14 +255,21 @@ double process_t::next_update_time() const
 
 std::shared_ptr< process_t > process_t::add_thread( std::shared_ptr< thread_t > thread_ptr )
 {
+    thread_ptr->_order = _threads.size();
     _threads.push_back( thread_ptr );
     thread_ptr->set_process( this->shared_from_this() );
+    if ( thread_ptr->is_active() )
+        _set_thread_active( thread_ptr.get(), true );
     return this->shared_from_this();
 }
 
-void process_t::set_id( size_t id, std::optional< world_key_t > world, std::optional< size_t > relative_id )
+const std::vector< std::shared_ptr< thread_t > > &process_t::get_threads() const { return _threads; }
+
+void process_t::set_id( size_t id, std::optional< world_key_t > world, std::optional< size_t > relative_id,
+                        std::optional< world_id_t > world_id )
 {
     _world_key = world;
+    _world_id = world_id;
     _relative_id = relative_id;
     _id = id;
 }
@@ -92,7 +285,10 @@ bool process_t::is_active() const { return _is_active; }
 void process_t::set_active( bool active )
 {
     this->_is_active = active;
-    if ( active && _system )
+    const auto system = _system.lock();
+    if ( system )
+        system->_set_process_active( this, active );
+    if ( active && system )
     {
         for ( auto &thread : _threads )
         {
@@ -105,7 +301,8 @@ void process_t::set_active( bool active )
 
 thread_t::thread_t( double compute_time, double sleep_time, double thread_time ) :
     _th_time( thread_time ), _c_time( compute_time ), _s_time( sleep_time ), _initial_th_time( thread_time ),
-    _initial_c_time( compute_time ), _initial_s_time( sleep_time ), _is_active( true ) {};
+    _initial_c_time( compute_time ), _initial_s_time( sleep_time ), _is_active( true ), _order( 0 ), _listed( false ),
+    _active_pos( npos ), _parked( false ), _wake_on_delivery( false ) {};
 
 
 void thread_t::init()
@@ -125,12 +322,21 @@ void thread_t::set_sleep_time( double _s_time ) { this->_s_time = _s_time; };
 
 void thread_t::schedule( double current_time )
 {
-    auto gl = get_global();
-    double noise = gl->get_random()->uniform_range( noise_min, noise_max );
+    const auto system = get_process()->get_system();
+    double noise = system->get_global()->get_random()->uniform_range( noise_min, noise_max );
     if ( this->_th_time > current_time )
         return;
+    if ( _wake_on_delivery && !has_message() )
+    {
+        wait_delivery();
+        return;
+    }
     fun();
-    _th_time += ( _c_time + _s_time ) * ( 1 + noise );
+    const double dt = ( _c_time + _s_time ) * ( 1 + noise );
+    if ( system->get_tick() == 0 )
+        _th_time += dt;
+    else if ( dt > 0 && std::isfinite( _th_time ) ) // parked threads stay at infinity
+        _th_time = system->to_time( system->to_ticks( _th_time ) + std::max< tick_t >( 1, system->to_ticks( dt ) ) );
 }
 
 void thread_t::set_process( std::shared_ptr< process_t > process ) { _process = process; }
@@ -140,15 +346,41 @@ std::optional< size_t > process_t::get_relative_id() const { return this->_relat
 
 std::optional< world_key_t > process_t::get_world_key() const { return this->_world_key; };
 
+std::optional< world_id_t > process_t::get_world_id() const { return this->_world_id; };
+
 
 bool thread_t::is_active() const { return _is_active; }
 
+void thread_t::set_wake_on_delivery( bool wake ) { _wake_on_delivery = wake; }
+
+bool thread_t::wakes_on_delivery() const { return _wake_on_delivery; }
+
+bool thread_t::has_message() const
+{
+    const auto process = _process.lock();
+    assert( process.get() != nullptr ); // MAKE SURE THIS THREAD IS ASSOCIATED TO A PROCESS
+    auto proc_id = process->get_id();
+    assert( proc_id.has_value() );      // MAKE SURE THIS THREAD'S PROCESS IS REGISTERD IN THE SYSTEM
+    return process->_aside_count > 0 ||
+           !process->get_system()->get_global()->get_channel_in()[proc_id.value()].empty();
+}
+
+void thread_t::wait_delivery()
+{
+    const auto process = _process.lock();
+    assert( process.get() != nullptr ); // MAKE SURE THIS THREAD IS ASSOCIATED TO A PROCESS
+    process->_park( this );
+}
+
 void thread_t::set_active( bool active )
 {
     this->_is_active = active;
-    if ( _process && active )
+    const auto process = _process.lock();
+    if ( process )
+        process->_set_thread_active( this, active );
+    if ( process && active )
     {
-        auto system = _process->get_system();
+        auto system = process->get_system();
         if ( !system )
             return;
         _th_time = system->get_current_time();
@@ -26,9 +26,14 @@
  */
 #include "system.hpp"
 #include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <stdexcept>
 #include "common.hpp"
 #include "network/network.hpp"
@@ -36,25 +41,48 @@
 
 using namespace isw;
 
-system_t::system_t( std::shared_ptr< global_t > global, const std::string &name ) : _global( global ), _name( name ) {}
+system_t::system_t( std::shared_ptr< global_t > global, const std::string &name ) :
+    _time( 0 ), _tick( 0 ), _reset_time( 0 ), _global( global ), _outstanding( 0 ), _name( name ), _running( false ),
+    _active_dirty( false ), _scheduling( false )
+{
+}
 
 void system_t::init()
 {
+    const auto start = std::chrono::steady_clock::now();
+    _restore_population();
     _global->init();
+
+    // channels have been emptied by global init
+    _outstanding = 0;
+    for ( auto &[world, count] : _world_outstanding )
+        count = 0;
+    _free_recipients.resize( _recipients.size() );
+    std::iota( _free_recipients.begin(), _free_recipients.end(), 0 );
+    for ( auto &list : _recipients )
+        list.clear();
+
+    // reset time for run
+    _time = 0;
+
+    // networks first, processes may send messages from their init
+    for ( auto &network : _networks )
+    {
+        network->init();
+    }
+    // in ID order, process inits may draw from the shared generator
     for ( auto &process : _processes )
     {
+        if ( !process )
+            continue;
         process->set_active( true ); //...
         process->init();
     }
-    for ( auto &network : _networks )
-    {
-        network->init();
-    }
-
-    // reset time for run
-    _time = 0;
+    _reset_time = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
 }
 
+double system_t::get_reset_time() const { return _reset_time; }
+
 std::shared_ptr< system_t > system_t::add_network( double nc_time, double ns_time, double nth_time )
 {
     auto net = std::make_shared< network_t >();
@@ -71,6 +99,23 @@ std::shared_ptr< system_t > system_t::add_network( std::shared_ptr< network_t >
     return shared_from_this();
 }
 
+std::shared_ptr< system_t > system_t::add_batch_network( size_t batch, double nc_time, double ns_time,
+                                                        double nth_time )
+{
+    auto net = std::make_shared< network_t >();
+    net->add_thread( std::make_shared< batch_scanner_t >( batch, nc_time, ns_time, nth_time ) );
+    return add_network( net );
+}
+
+std::shared_ptr< system_t > system_t::add_sharded_network( size_t shards, shard_mode_t mode, double nc_time,
+                                                          double ns_time, double nth_time )
+{
+    auto net = std::make_shared< network_t >();
+    for ( size_t shard = 0; shard < shards; shard++ )
+        net->add_thread( std::make_shared< shard_scanner_t >( shard, shards, mode, nc_time, ns_time, nth_time ) );
+    return add_network( net );
+}
+
 std::shared_ptr< system_t > system_t::add_pid_network( double obj_occupancy, double th_time, double error_threshold )
 {
     auto net = std::make_shared< network_t >();
@@ -78,15 +123,19 @@ std::shared_ptr< system_t > system_t::add_pid_network( double obj_occupancy, dou
     return add_network( net );
 }
 
+std::shared_ptr< system_t > system_t::add_pid_network( const pid_gains_t &gains, double obj_occupancy,
+                                                      double th_time, double error_threshold )
+{
+    auto net = std::make_shared< network_t >();
+    net->add_thread( std::make_shared< pid_scanner_t >( obj_occupancy, th_time, error_threshold, gains ) );
+    return add_network( net );
+}
+
 void system_t::_update_time()
 {
     double time = std::numeric_limits< double >::infinity();
-    for ( auto &proc : _processes )
-    {
-        if ( !proc->is_active() )
-            continue;
-        time = std::min< double >( proc->next_update_time(), time );
-    }
+    for ( auto id : _active )
+        time = std::min< double >( _processes[id]->next_update_time(), time );
     for ( auto &net : _networks )
         time = std::min< double >( net->next_update_time(), time );
     _time = time;
@@ -94,15 +143,25 @@ void system_t::_update_time()
 
 void system_t::step()
 {
+    _running = true;
+    _sort_active();
     _update_time();
     // auto shuffled = _processes;
     // std::shuffle( shuffled.begin(), shuffled.end(), _global->get_random()->get_engine() );
-    for ( auto &proc : _processes )
+    // processes may spawn, retire or (de)activate others while being scheduled: the ones activated now wait for
+    // the next step, the deactivated ones stay listed until the loop is over
+    _scheduling = true;
+    const size_t listed = _active.size();
+    for ( size_t pos = 0; pos < listed; pos++ )
     {
-        if ( !proc->is_active() )
+        // a copy: the slot is the only owner of the process, which may retire itself while scheduled
+        const auto proc = _processes[_active[pos]];
+        if ( !proc || !proc->is_active() )
             continue;
         proc->schedule( _time );
     }
+    _scheduling = false;
+    _sort_active();
     for ( auto &net : _networks )
         net->schedule( _time );
     on_end_step();
@@ -112,20 +171,208 @@ void system_t::on_end_step() {};
 
 std::shared_ptr< system_t > system_t::add_process( process_ptr_t p, world_key_t world_key )
 {
+    spawn_process( p, world_key );
+    return shared_from_this();
+}
+
+process_handle_t system_t::spawn_process( process_ptr_t p, world_key_t world_key )
+{
+    const world_id_t world_id = _intern_world( world_key );
+    size_t id;
+    const bool reused = !_free_slots.empty();
+    if ( reused )
+    {
+        id = _free_slots.back();
+        _free_slots.pop_back();
+        // messages sent to the dead slot were stamped after the retirement, they must not reach the newcomer
+        _generations[id]++;
+        _transient[id] = _running;
+        _processes[id] = p;
+        _world_of[id] = world_id;
+        _outstanding_of[id] = &_world_outstanding[world_key];
+    }
+    else
+    {
+        id = _processes.size();
+        _processes.push_back( p );
+        _generations.push_back( 0 );
+        _world_of.push_back( world_id );
+        _live_pos.push_back( 0 );
+        _active_pos.push_back( npos );
+        _transient.push_back( _running );
+        _outstanding_of.push_back( &_world_outstanding[world_key] );
+
+        auto &in = _global->get_channel_in();
+        auto &out = _global->get_channel_out();
+        out.resize( _processes.size() );
+        in.resize( _processes.size() );
+    }
+    _live_pos[id] = _live.size();
+    _live.push_back( id );
 
-    const auto id = _processes.size();
-    _processes.push_back( p );
-    const auto rel_id = _worlds[world_key].size();
     _worlds[world_key].insert( id ); // assert
     const auto shared = this->shared_from_this();
     p->set_system( shared );
-    p->set_id( id, world_key, rel_id );
+    if ( reused )
+        _renumber( world_key, id );
+    else
+        p->set_id( id, world_key, _worlds[world_key].size() - 1, world_id );
 
-    auto &in = _global->get_channel_in();
-    auto &out = _global->get_channel_out();
-    out.resize( _processes.size() );
-    in.resize( _processes.size() );
-    return shared_from_this();
+    _world_versions[world_id]++;
+    if ( p->is_active() )
+        _set_process_active( p.get(), true );
+
+    for ( auto &net : _networks )
+        net->on_spawn( id );
+    return { id, _generations[id] };
+}
+
+void system_t::retire_process( process_handle_t handle )
+{
+    if ( !is_alive( handle ) )
+        throw std::out_of_range( "stale process handle" );
+    const size_t id = handle.id;
+    auto &process = _processes[id];
+    const world_key_t world_key = process->get_world_key().value();
+    if ( _running && !_transient[id] )
+        _retired_in_run.push_back( { process, world_key, id } );
+    _transient[id] = false;
+
+    // recycle the channels, discarding pending messages
+    auto &out = _global->get_channel_out()[id];
+    _outstanding -= out.size();
+    *_outstanding_of[id] -= out.size();
+    while ( !out.empty() )
+    {
+        if ( out.front()->receiver == network::multicast_receiver )
+            release_recipients( *out.front() );
+        out.pop();
+    }
+    _global->get_channel_in()[id].clear();
+
+    // swap-remove from the live list
+    const size_t pos = _live_pos[id];
+    _live[pos] = _live.back();
+    _live_pos[_live[pos]] = pos;
+    _live.pop_back();
+
+    _worlds[world_key].erase( id );
+    _world_versions[_world_of[id]]++;
+    _renumber( world_key, id );
+    process->set_active( false );
+    process = nullptr;
+    _generations[id]++;
+    _free_slots.push_back( id );
+
+    for ( auto &net : _networks )
+        net->on_retire( id );
+}
+
+void system_t::_restore_population()
+{
+    _running = false;
+    for ( size_t id = 0; id < _processes.size(); id++ )
+        if ( _processes[id] && _transient[id] )
+            retire_process( get_handle( id ) );
+    // latest retirement first, each process gets its slot back
+    for ( auto it = _retired_in_run.rbegin(); it != _retired_in_run.rend(); ++it )
+    {
+        std::iter_swap( std::find( _free_slots.begin(), _free_slots.end(), it->id ), _free_slots.end() - 1 );
+        spawn_process( it->process, it->world );
+    }
+    _retired_in_run.clear();
+    // every run reuses the free slots in the same order, lowest first
+    std::sort( _free_slots.begin(), _free_slots.end(), std::greater< size_t >() );
+}
+
+process_handle_t system_t::get_handle( size_t id ) const
+{
+    if ( id >= _processes.size() || !_processes[id] )
+        throw std::out_of_range( "no live process with this ID" );
+    return { id, _generations[id] };
+}
+
+bool system_t::is_alive( process_handle_t handle ) const
+{
+    return handle.id < _processes.size() && _processes[handle.id] && _generations[handle.id] == handle.generation;
+}
+
+const std::vector< size_t > &system_t::live_processes() const { return _live; }
+
+void system_t::_set_process_active( const process_t *process, bool active )
+{
+    // networks and processes of other systems are not listed
+    auto id = process->get_id();
+    if ( !id.has_value() || id.value() >= _processes.size() || _processes[id.value()].get() != process )
+        return;
+    const size_t pid = id.value();
+    const size_t pos = _active_pos[pid];
+    if ( active && pos == npos )
+    {
+        _active_pos[pid] = _active.size();
+        _active.push_back( pid );
+        _active_dirty = true;
+    }
+    else if ( !active && pos != npos )
+    {
+        _active_dirty = true;
+        // the step is iterating the list, the entry is dropped by _sort_active once it is over
+        if ( _scheduling )
+            return;
+        _active[pos] = _active.back();
+        _active_pos[_active[pos]] = pos;
+        _active.pop_back();
+        _active_pos[pid] = npos;
+    }
+}
+
+void system_t::_sort_active()
+{
+    if ( !_active_dirty )
+        return;
+    auto inactive = [this]( size_t id )
+    {
+        if ( _processes[id] && _processes[id]->is_active() )
+            return false;
+        _active_pos[id] = npos;
+        return true;
+    };
+    _active.erase( std::remove_if( _active.begin(), _active.end(), inactive ), _active.end() );
+    // ID order: the scheduling order, and so same time events and noise draws, must not depend on the history of
+    // (de)activations
+    std::sort( _active.begin(), _active.end() );
+    for ( size_t pos = 0; pos < _active.size(); pos++ )
+        _active_pos[_active[pos]] = pos;
+    _active_dirty = false;
+}
+
+bool system_t::deliver( const std::shared_ptr< network::message_t > &msg )
+{
+    if ( msg->receiver != network::multicast_receiver )
+        return deliver( msg, { msg->receiver, msg->receiver_generation } );
+    bool delivered = false;
+    for ( auto to : _recipients[msg->recipients] )
+        delivered = deliver( msg, to ) || delivered;
+    release_recipients( *msg );
+    return delivered;
+}
+
+bool system_t::deliver( const std::shared_ptr< network::message_t > &msg, process_handle_t to )
+{
+    if ( !is_alive( to ) )
+        return false;
+    _global->get_channel_in()[to.id].push( msg );
+    _processes[to.id]->notify_delivery( _time );
+    return true;
+}
+
+void system_t::_renumber( const world_key_t &world, size_t from )
+{
+    auto &world_set = _worlds[world];
+    const world_id_t world_id = _world_ids.at( world );
+    size_t rel_id = std::distance( world_set.begin(), world_set.lower_bound( from ) );
+    for ( auto it = world_set.lower_bound( from ); it != world_set.end(); ++it )
+        _processes[*it]->set_id( *it, world, rel_id++, world_id );
 }
 
 size_t system_t::get_abs_id( world_key_t world, size_t rel_id ) const
@@ -171,8 +418,33 @@ world_entry_t system_t::get_rel_id( size_t abs_id ) const
 
 const std::vector< process_ptr_t > &system_t::get_processes() const { return _processes; }
 
+const std::vector< std::shared_ptr< network_t > > &system_t::get_networks() const { return _networks; }
+
 double system_t::get_current_time() const { return _time; }
 
+void system_t::set_tick( double tick )
+{
+    if ( tick < 0 )
+        throw std::runtime_error( "negative tick" );
+    _tick = tick;
+}
+
+double system_t::get_tick() const { return _tick; }
+
+tick_t system_t::to_ticks( double time ) const
+{
+    if ( _tick <= 0 )
+        throw std::logic_error( "no integer time base, see set_tick" );
+    return std::llround( time / _tick );
+}
+
+double system_t::to_time( tick_t ticks ) const
+{
+    if ( _tick <= 0 )
+        throw std::logic_error( "no integer time base, see set_tick" );
+    return static_cast< double >( ticks ) * _tick;
+}
+
 
 std::shared_ptr< system_t > system_t::create( std::shared_ptr< global_t > global, std::string name )
 {
@@ -192,8 +464,137 @@ size_t system_t::world_size( world_key_t world ) const
 
 size_t system_t::total_worlds() const { return _worlds.size(); };
 
+world_id_t system_t::world_id( const world_key_t &world ) const
+{
+    auto it = _world_ids.find( world );
+    if ( it == _world_ids.end() )
+    {
+        throw std::out_of_range( "world key not found" );
+    }
+    return it->second;
+}
+
+const world_key_t &system_t::world_key( world_id_t id ) const
+{
+    if ( id >= _world_keys.size() )
+    {
+        throw std::out_of_range( "world ID not found" );
+    }
+    return _world_keys[id];
+}
+
+world_id_t system_t::_intern_world( const world_key_t &world )
+{
+    auto [it, inserted] = _world_ids.try_emplace( world, static_cast< world_id_t >( _world_keys.size() ) );
+    if ( inserted )
+    {
+        _world_keys.push_back( world );
+        _world_versions.push_back( 1 );
+        _views.emplace_back();
+    }
+    return it->second;
+}
+
 void system_t::send_message( std::shared_ptr< network::message_t > msg )
 {
+    if ( msg->receiver >= _processes.size() )
+        throw std::out_of_range( "receiver ID out of range" );
+    msg->receiver_generation = _generations[msg->receiver];
+    _post( msg );
+}
+
+void system_t::multicast( std::shared_ptr< network::message_t > msg, const std::vector< size_t > &receivers )
+{
+    if ( receivers.empty() )
+        return;
+    const u32_t slot = _acquire_recipients();
+    auto &list = _recipients[slot];
+    for ( auto id : receivers )
+    {
+        if ( id >= _processes.size() || !_processes[id] )
+        {
+            list.clear();
+            _free_recipients.push_back( slot );
+            throw std::out_of_range( "no live process with this ID" );
+        }
+        list.push_back( { id, _generations[id] } );
+    }
+    msg->receiver = network::multicast_receiver;
+    msg->receiver_generation = 0;
+    msg->recipients = slot;
+    _post( msg );
+}
+
+void system_t::broadcast( std::shared_ptr< network::message_t > msg, const world_key_t &world )
+{
+    auto it = _worlds.find( world );
+    if ( it == _worlds.end() )
+    {
+        throw std::out_of_range( "world key not found" );
+    }
+    if ( it->second.empty() )
+        return;
+    const u32_t slot = _acquire_recipients();
+    auto &list = _recipients[slot];
+    for ( auto id : it->second )
+        list.push_back( { id, _generations[id] } );
+    msg->receiver = network::multicast_receiver;
+    msg->receiver_generation = 0;
+    msg->recipients = slot;
+    _post( msg );
+}
+
+const std::vector< process_handle_t > &system_t::recipients( const network::message_t &msg ) const
+{
+    assert( msg.receiver == network::multicast_receiver );
+    return _recipients[msg.recipients];
+}
+
+void system_t::release_recipients( const network::message_t &msg )
+{
+    assert( msg.receiver == network::multicast_receiver );
+    _recipients[msg.recipients].clear();
+    _free_recipients.push_back( msg.recipients );
+}
+
+u32_t system_t::_acquire_recipients()
+{
+    if ( _free_recipients.empty() )
+    {
+        _recipients.emplace_back();
+        return static_cast< u32_t >( _recipients.size() - 1 );
+    }
+    const u32_t slot = _free_recipients.back();
+    _free_recipients.pop_back();
+    return slot;
+}
+
+void system_t::_post( const std::shared_ptr< network::message_t > &msg )
+{
+    msg->world_id = _world_of[msg->sender];
+    for ( auto &net : _networks )
+        if ( net->on_send( msg ) )
+            return;
     auto &out = _global->get_channel_out();
     out[msg->sender].push( msg );
+    _outstanding++;
+    ( *_outstanding_of[msg->sender] )++;
+}
+
+void system_t::on_dequeue( size_t sender )
+{
+    _outstanding--;
+    ( *_outstanding_of[sender] )--;
+}
+
+size_t system_t::outstanding_messages() const { return _outstanding; }
+
+size_t system_t::outstanding_messages( const world_key_t &world ) const
+{
+    auto it = _world_outstanding.find( world );
+    if ( it == _world_outstanding.end() )
+    {
+        throw std::out_of_range( "world key not found" );
+    }
+    return it->second;
 }
@@ -0,0 +1,96 @@
+/*
+ * File: task_thread.cpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This file implements the task_thread_t class for wait-driven thread logic.
+ */
+#include "task_thread.hpp"
+#include <algorithm>
+#include <limits>
+
+using namespace isw;
+
+task_thread_t::task_thread_t( double th_time ) :
+    thread_t( 0, 0, th_time ), _wait( wait_t::TIME ), _next( [this]() { run(); } )
+{
+}
+
+void task_thread_t::init()
+{
+    thread_t::init();
+    _wait = wait_t::TIME;
+    _next = [this]() { run(); };
+    _receive = nullptr;
+}
+
+void task_thread_t::fun()
+{
+    if ( _wait == wait_t::MESSAGE )
+    {
+        auto receive = std::move( _receive );
+        _wait = wait_t::NONE;
+        // woken up without a matching message, e.g. by a reactivation
+        if ( !receive() )
+        {
+            _receive = std::move( receive );
+            _wait = wait_t::MESSAGE;
+            wait_delivery();
+            return;
+        }
+    }
+    else
+    {
+        auto next = std::move( _next );
+        _next = nullptr;
+        _wait = wait_t::NONE;
+        next();
+    }
+    if ( _wait == wait_t::NONE )
+    {
+        set_active( false );
+        set_thread_time( std::numeric_limits< double >::infinity() );
+    }
+}
+
+bool task_thread_t::finished() const { return _wait == wait_t::NONE; }
+
+void task_thread_t::sleep( double dt, continuation_t next )
+{
+    set_thread_time( get_thread_time() + dt );
+    _await( wait_t::TIME, std::move( next ) );
+}
+
+void task_thread_t::wait_until( double time, continuation_t next )
+{
+    set_thread_time( std::max( time, get_thread_time() ) );
+    _await( wait_t::TIME, std::move( next ) );
+}
+
+void task_thread_t::_await( wait_t wait, continuation_t next )
+{
+    _wait = wait;
+    _next = std::move( next );
+    // a queued message resumes the thread at the current time
+    if ( wait == wait_t::MESSAGE && !has_message() )
+        wait_delivery();
+}
@@ -29,10 +29,27 @@
 
 using namespace isw::cs;
 
-server_t::server_t(size_t db_size, fill init, std::string name) : process_t(name), database(db_size), _init(init) {}
+server_t::server_t(size_t db_size, fill init, std::string name) : 
+    process_t(name), database(db_size), _init(init), _use_image(false), _has_image(false) {}
 
 void server_t::init() {
     process_t::init();
+    if (_has_image) {
+        database.assign(_image.begin(), _image.end());
+        return;
+    }
     for (size_t i = 0; i < database.size(); i++)
         database[i] = _init(i);
+    if (_use_image) {
+        _image = database;
+        _has_image = true;
+    }
+}
+
+void server_t::set_init_image(bool image) {
+    _use_image = image;
+    if (!image) {
+        _has_image = false;
+        _image.clear();
+    }
 }
@@ -0,0 +1,155 @@
+/*
+ * File: population.cpp
+ * Copyright (c) 2025 bernie_gui, uniquadev, SepeFr.
+ *
+ * This file is part of SWE_exam_library
+ *
+ * SWE_exam_library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE_exam_library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * University: Sapienza University of Rome
+ * Instructor: Enrico Tronci
+ * Academic Year: 2025-2026
+ *
+ * Description:
+ *	This file implements the population_t process for batched homogeneous entities.
+ */
+#include "utils/population.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+using namespace isw::utils;
+
+/**
+ * @brief Thread of a population_t, scheduled at the earliest entity time.
+ * @details Compute and sleep times are 0, the thread time is set by the population after each batch.
+ */
+class population_t::batch_thread_t : public isw::thread_t {
+    public:
+        batch_thread_t(population_t &population, double th_time) : 
+            thread_t(0, 0, th_time), _population(population) {}
+        void fun() override { _population._run_batch(get_thread_time()); }
+
+    private:
+        population_t &_population;
+};
+
+population_t::population_t(size_t size, kernel batch_kernel, double c_time, double s_time, 
+    double th_time, std::string name) : 
+    process_t(name), _kernel(batch_kernel), _c_time(c_time), _initial_s_time(s_time), 
+    _initial_th_time(th_time), _time(size, th_time), _version(size, 0), _sleep(size, s_time), _batches(0) {
+        _rebuild();
+    }
+
+std::shared_ptr<population_t> population_t::create(size_t size, kernel batch_kernel, double c_time, 
+    double s_time, double th_time, std::string name) {
+        return std::make_shared<population_t>(size, batch_kernel, c_time, s_time, th_time, name);
+    }
+
+size_t population_t::add_column(const std::string &name, column_init init) {
+    _columns.emplace_back(size(), 0.0);
+    _names.push_back(name);
+    _inits.push_back(init);
+    if (init)
+        for (size_t i = 0; i < size(); i++)
+            _columns.back()[i] = init(i);
+    return _columns.size() - 1;
+}
+
+std::vector<double> &population_t::column(size_t idx) {
+    return _columns[idx];
+}
+
+std::vector<double> &population_t::column(const std::string &name) {
+    auto it = std::find(_names.begin(), _names.end(), name);
+    if (it == _names.end())
+        throw std::out_of_range("column not found, " + name);
+    return _columns[it - _names.begin()];
+}
+
+size_t population_t::size() const { return _time.size(); }
+
+double population_t::get_entity_time(size_t idx) const { return _time[idx]; }
+
+void population_t::set_entity_time(size_t idx, double time) {
+    _time[idx] = time;
+    _schedule(idx);
+    // wake up earlier if needed, the next wake-up is taken from the heap after each batch anyway
+    if (_thread && time < _thread->get_thread_time())
+        _thread->set_thread_time(time);
+}
+
+void population_t::set_entity_sleep(size_t idx, double s_time) { _sleep[idx] = s_time; }
+
+size_t population_t::batches() const { return _batches; }
+
+void population_t::init() {
+    if (!_thread) {
+        _thread = std::make_shared<batch_thread_t>(*this, _initial_th_time);
+        add_thread(_thread);
+    }
+    process_t::init();
+    std::fill(_time.begin(), _time.end(), _initial_th_time);
+    std::fill(_sleep.begin(), _sleep.end(), _initial_s_time);
+    for (size_t c = 0; c < _columns.size(); c++)
+        for (size_t i = 0; i < size(); i++)
+            _columns[c][i] = _inits[c] ? _inits[c](i) : 0.0;
+    _batches = 0;
+    _rebuild();
+}
+
+void population_t::_run_batch(double current_time) {
+    _due.clear();
+    for (_skip_stale(); !_wakeups.empty() && _wakeups.top().time <= current_time; _skip_stale()) {
+        _due.push_back(_wakeups.top().idx);
+        _wakeups.pop();
+    }
+
+    if (!_due.empty()) {
+        // the kernel sees the due entities in index order, whatever time they were due at
+        std::sort(_due.begin(), _due.end());
+        _kernel(*this, _due);
+        _batches++;
+        for (auto i : _due)
+            if (_time[i] <= current_time) { // the kernel may have rescheduled the entity itself
+                _time[i] += _c_time + _sleep[i];
+                _schedule(i);
+            }
+    }
+
+    // parked and rescheduled entities leave stale wake-ups behind, keep the heap within twice the population
+    if (_wakeups.size() > 2 * size())
+        _rebuild();
+    _skip_stale();
+    _thread->set_thread_time(_wakeups.empty() ? std::numeric_limits<double>::infinity() : _wakeups.top().time);
+}
+
+void population_t::_schedule(size_t idx) {
+    _version[idx]++;
+    if (_time[idx] < std::numeric_limits<double>::infinity())
+        _wakeups.push({_time[idx], idx, _version[idx]});
+}
+
+void population_t::_skip_stale() {
+    while (!_wakeups.empty() && _wakeups.top().version != _version[_wakeups.top().idx])
+        _wakeups.pop();
+}
+
+void population_t::_rebuild() {
+    std::vector<wakeup_t> wakeups;
+    wakeups.reserve(size());
+    for (size_t i = 0; i < size(); i++)
+        if (_time[i] < std::numeric_limits<double>::infinity())
+            wakeups.push_back({_time[i], i, _version[i]});
+    _wakeups = decltype(_wakeups)(later_t(), std::move(wakeups));
+}
@@ -27,6 +27,15 @@
 #include "utils/vehicles/functions.hpp"
 
 size_t isw::uv::count_collisions( const std::vector< std::shared_ptr< vehicle_t > > &vehicles, double coll_radius )
+{
+    std::vector< vehicle_t * > raw;
+    raw.reserve( vehicles.size() );
+    for ( auto &v : vehicles )
+        raw.push_back( v.get() );
+    return count_collisions( raw, coll_radius );
+}
+
+size_t isw::uv::count_collisions( const std::vector< vehicle_t * > &vehicles, double coll_radius )
 {
     size_t id1, id2, collision_count = 0;
     double dist = 0;
@@ -37,7 +46,7 @@ size_t isw::uv::count_collisions( const std::vector< std::shared_ptr< vehicle_t
             id2 = v2->get_relative_id().value();
             if ( id1 >= id2 )
                 continue;
-            dist = euclidean_distance( v1, v2 );
+            dist = euclidean_distance( *v1, *v2 );
             if ( dist > coll_radius )
                 continue;
             collision_count++;
@@ -46,11 +55,16 @@ size_t isw::uv::count_collisions( const std::vector< std::shared_ptr< vehicle_t
 }
 
 double isw::uv::euclidean_distance( std::shared_ptr< vehicle_t > v1, std::shared_ptr< vehicle_t > v2 )
+{
+    return euclidean_distance( *v1, *v2 );
+}
+
+double isw::uv::euclidean_distance( const vehicle_t &v1, const vehicle_t &v2 )
 {
     double temp, dist = 0;
-    for ( size_t i = 0; i < v1->pos.size(); i++ )
+    for ( size_t i = 0; i < v1.pos.size(); i++ )
     {
-        temp = v1->pos[i] - v2->pos[i];
+        temp = v1.pos[i] - v2.pos[i];
         dist += temp * temp;
     }
     dist = std::sqrt( dist );
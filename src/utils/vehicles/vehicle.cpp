@@ -34,7 +34,7 @@ using namespace isw::uv;
 
 vehicle_t::vehicle_t(size_t dimensions, fill init_pos, fill init_vel, std::string name) : 
     process_t(name), pos(dimensions), vel(dimensions), 
-    _init_pos(init_pos), _init_vel(init_vel) {}
+    _init_pos(init_pos), _init_vel(init_vel), _use_image(false), _has_image(false) {}
 
 double vehicle_t::get_pos(size_t idx) {
     return pos[idx];
@@ -46,10 +46,29 @@ double vehicle_t::get_vel(size_t idx) {
 
 void vehicle_t::init() {
     process_t::init();
+    if (_has_image) {
+        pos.assign(_image_pos.begin(), _image_pos.end());
+        vel.assign(_image_vel.begin(), _image_vel.end());
+        return;
+    }
     for (size_t i = 0; i < pos.size(); i++) {
         pos[i] = _init_pos(i);
         vel[i] = _init_vel(i);
     }
+    if (_use_image) {
+        _image_pos = pos;
+        _image_vel = vel;
+        _has_image = true;
+    }
+}
+
+void vehicle_t::set_init_image(bool image) {
+    _use_image = image;
+    if (!image) {
+        _has_image = false;
+        _image_pos.clear();
+        _image_vel.clear();
+    }
 }
 
 std::shared_ptr<vehicle_t> vehicle_t::create_process(size_t dimensions, double c_time, 
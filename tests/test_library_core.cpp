@@ -6,7 +6,7 @@
  * @details Exercise-independent tests covering the fundamental library classes:
  *          random_t, global_t, system_t, process_t, thread_t, simulator_t,
  *          input_parser_t, lambda_parser_t, output_writer_t, logger_t,
- *          markov_chain, rate_meas_t.
+ *          binary_logger_t, markov_chain, rate_meas_t, network scanners.
  */
 
 #include <cmath>
@@ -17,6 +17,7 @@
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -29,12 +30,23 @@
 #include "random.hpp"
 #include "simulator.hpp"
 #include "system.hpp"
+#include "task_thread.hpp"
+#include "io/binary_logger.hpp"
 #include "io/input_parser.hpp"
 #include "io/lambda_parser.hpp"
 #include "io/logger.hpp"
 #include "io/output_writer.hpp"
+#include "network/latency_network.hpp"
+#include "network/network.hpp"
+#include "network/pid_network.hpp"
+#include "network/pid_tuner.hpp"
+#include "network/value_network.hpp"
+#include "utils/customer-server/server.hpp"
+#include "utils/customer-server/supplier.hpp"
 #include "utils/markov/markov.hpp"
+#include "utils/population.hpp"
 #include "utils/rate.hpp"
+#include "utils/vehicles/vehicle.hpp"
 
 using namespace isw;
 
@@ -433,6 +445,7 @@ TEST_CASE("simulator_t: on_terminate called once per montecarlo iteration", "[si
     mc->run();
 
     REQUIRE(global_terminate_count == 50);
+    REQUIRE(mc->get_reset_time() >= 0);
 }
 
 // ============================================================================
@@ -533,6 +546,32 @@ TEST_CASE("output_writer_t: write result format", "[output_writer][io]") {
     std::filesystem::remove(tmp);
 }
 
+TEST_CASE("output_writer_t: async mode preserves content and order", "[output_writer][io]") {
+    const std::string tmp = "tests/_tmp_output_async.txt";
+    {
+        output_writer_t writer(tmp);
+        writer.set_async(4);
+        writer.write_line("header-line");
+        for (int i = 0; i < 100; ++i)
+            writer << "R " << i << std::endl;
+        writer.flush();
+        REQUIRE(writer.dropped() == 0);
+        REQUIRE_THROWS_AS(writer.get_stream(), std::runtime_error);
+    }
+
+    std::ifstream in(tmp);
+    std::string line;
+    std::getline(in, line);
+    REQUIRE(line == "header-line");
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(std::getline(in, line));
+        REQUIRE(line == "R " + std::to_string(i));
+    }
+
+    in.close();
+    std::filesystem::remove(tmp);
+}
+
 TEST_CASE("output_writer_t: writes arbitrary key-value lines", "[output_writer][io]") {
     const std::string tmp = "tests/_tmp_output_kv.txt";
     {
@@ -622,6 +661,200 @@ TEST_CASE("logger_t: full logging workflow", "[logger][io]") {
     std::filesystem::remove(tmp);
 }
 
+TEST_CASE("binary_logger_t: round-trips typed columns through to_csv", "[logger][io]") {
+    const std::string tmp = "tests/_tmp_trace.bin";
+    const std::string csv = "tests/_tmp_trace.csv";
+    {
+        // block of 2 rows forces one full block flush plus a partial one on destruction
+        auto logger = binary_logger_t::create(tmp, 2);
+        logger->add_field("step", field_type_t::INTEGER)
+              ->add_field("time")
+              ->log_fields();
+        for (int i = 0; i < 3; ++i)
+            logger->add_measurement(i)->add_measurement(i * 0.5)->log_measurement();
+        REQUIRE(logger->rows() == 3);
+    }
+    binary_logger_t::to_csv(tmp, csv);
+
+    std::ifstream in(csv);
+    std::string line;
+    std::getline(in, line);
+    REQUIRE(line == "step time ");
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(std::getline(in, line));
+        std::istringstream iss(line);
+        long step;
+        double time;
+        iss >> step >> time;
+        REQUIRE(step == i);
+        REQUIRE(time == Catch::Approx(i * 0.5));
+    }
+    REQUIRE_FALSE(std::getline(in, line));
+
+    in.close();
+    std::filesystem::remove(tmp);
+    std::filesystem::remove(csv);
+}
+
+TEST_CASE("binary_logger_t: schema violations throw", "[logger][io]") {
+    const std::string tmp = "tests/_tmp_trace2.bin";
+    {
+        auto logger = binary_logger_t::create(tmp);
+        logger->add_field("a");
+        REQUIRE_THROWS(logger->add_measurement(1.0));
+        logger->log_fields();
+        REQUIRE_THROWS(logger->add_field("b"));
+        logger->add_measurement(1.0);
+        REQUIRE_THROWS(logger->add_measurement(2.0));
+        REQUIRE_NOTHROW(logger->log_measurement());
+    }
+    {
+        auto logger = binary_logger_t::create(tmp);
+        logger->add_field("n", field_type_t::INTEGER)->log_fields();
+        REQUIRE_THROWS(logger->add_measurement(std::numeric_limits<double>::quiet_NaN()));
+        REQUIRE_THROWS(logger->add_measurement(std::numeric_limits<double>::infinity()));
+        REQUIRE_THROWS(logger->add_measurement(1e19));
+        REQUIRE_NOTHROW(logger->add_measurement(-9.5));
+        REQUIRE_NOTHROW(logger->log_measurement());
+    }
+    std::filesystem::remove(tmp);
+}
+
+TEST_CASE("logger_t: async mode writes every line", "[logger][io]") {
+    const std::string tmp = "tests/_tmp_log_async.csv";
+    {
+        auto logger = logger_t::create(tmp);
+        logger->set_async(8)->add_field("i")->log_fields();
+        for (int i = 0; i < 1000; ++i)
+            logger->add_measurement(std::to_string(i))->log_measurement();
+        logger->flush();
+        REQUIRE(logger->dropped() == 0);
+        REQUIRE_THROWS(logger->set_async());
+    }
+
+    std::ifstream in(tmp);
+    std::string line;
+    size_t lines = 0;
+    while (std::getline(in, line))
+        lines++;
+    REQUIRE(lines == 1001);
+
+    in.close();
+    std::filesystem::remove(tmp);
+}
+
+TEST_CASE("logger_t: async drop policy counts discarded lines", "[logger][io]") {
+    const std::string tmp = "tests/_tmp_log_drop.csv";
+    size_t dropped = 0;
+    {
+        auto logger = logger_t::create(tmp);
+        logger->set_async(1, backpressure_t::DROP)->add_field("i")->log_fields();
+        for (int i = 0; i < 10000; ++i)
+            logger->add_measurement("x")->log_measurement();
+        logger->flush();
+        dropped = logger->dropped();
+    }
+
+    std::ifstream in(tmp);
+    std::string line;
+    size_t lines = 0;
+    while (std::getline(in, line))
+        lines++;
+    REQUIRE(lines + dropped == 10001);
+
+    in.close();
+    std::filesystem::remove(tmp);
+}
+
+static std::vector<std::string> read_lines(const std::string &path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line))
+        lines.push_back(line);
+    return lines;
+}
+
+TEST_CASE("logger_t: sampling modes", "[logger][io]") {
+    const std::string tmp = "tests/_tmp_log_sampling.csv";
+
+    SECTION("every nth record") {
+        {
+            auto logger = logger_t::create(tmp);
+            logger->sample_every(10)->add_field("i")->log_fields();
+            for (int i = 0; i < 100; ++i)
+                logger->add_measurement(static_cast<double>(i))->log_measurement();
+        }
+        auto lines = read_lines(tmp);
+        REQUIRE(lines.size() == 11);
+        REQUIRE(lines[1] == "0 ");
+        REQUIRE(lines[2] == "10 ");
+    }
+
+    SECTION("on change beyond threshold") {
+        {
+            auto logger = logger_t::create(tmp);
+            logger->sample_on_change(0.5)->add_field("x")->log_fields();
+            for (double x : {1.0, 1.2, 1.4, 2.0, 2.1, 5.0})
+                logger->add_measurement(x)->log_measurement();
+        }
+        auto lines = read_lines(tmp);
+        REQUIRE(lines.size() == 4);
+        REQUIRE(lines[1] == "1 ");
+        REQUIRE(lines[2] == "2 ");
+        REQUIRE(lines[3] == "5 ");
+    }
+
+    SECTION("on change ignores fields that are not watched") {
+        {
+            auto logger = logger_t::create(tmp);
+            logger->sample_on_change(0.5, {"x"})->add_field("t")->add_field("x")->log_fields();
+            double t = 0;
+            for (double x : {1.0, 1.2, 2.0, 2.1})
+                logger->add_measurement(t++)->add_measurement(x)->log_measurement();
+        }
+        auto lines = read_lines(tmp);
+        REQUIRE(lines.size() == 3);
+        REQUIRE(lines[1] == "0 1 ");
+        REQUIRE(lines[2] == "2 2 ");
+    }
+
+    SECTION("reservoir keeps k records in arrival order") {
+        {
+            auto logger = logger_t::create(tmp);
+            logger->sample_reservoir(5, std::make_shared<random_t>(42))->add_field("i")->log_fields();
+            for (int i = 0; i < 1000; ++i)
+                logger->add_measurement(static_cast<double>(i))->log_measurement();
+        }
+        auto lines = read_lines(tmp);
+        REQUIRE(lines.size() == 6);
+        for (size_t i = 2; i < lines.size(); ++i)
+            REQUIRE(std::stod(lines[i - 1]) < std::stod(lines[i]));
+    }
+
+    SECTION("time buckets aggregate min mean max") {
+        {
+            auto logger = logger_t::create(tmp);
+            logger->sample_buckets("t", 1.0)->add_field("t")->add_field("q")->log_fields();
+            for (double t : {0.0, 0.25, 0.5, 1.5, 1.75})
+                logger->add_measurement(t)->add_measurement(t * 4)->log_measurement();
+        }
+        auto lines = read_lines(tmp);
+        REQUIRE(lines.size() == 3);
+        REQUIRE(lines[0] == "t q_min q_mean q_max ");
+        REQUIRE(lines[1] == "0 0 1 2 ");
+        REQUIRE(lines[2] == "1 6 6.5 7 ");
+    }
+
+    SECTION("mode cannot change after the schema is logged") {
+        auto logger = logger_t::create(tmp);
+        logger->add_field("i")->log_fields();
+        REQUIRE_THROWS(logger->sample_every(2));
+    }
+
+    std::filesystem::remove(tmp);
+}
+
 // ============================================================================
 // SECTION 8: markov_chain utility
 // ============================================================================
@@ -692,3 +925,1174 @@ TEST_CASE("rate_meas_t: update at time zero throws", "[rate]") {
     isw::utils::rate_meas_t rate;
     REQUIRE_THROWS(rate.update(10.0, 0.0));
 }
+
+// ============================================================================
+// SECTION 10: network scanners
+// ============================================================================
+
+// sends `count` messages to process `target` on its first activation, then sleeps
+class burst_sender_t : public thread_t {
+public:
+    burst_sender_t(size_t target, size_t count, double period = 1)
+        : thread_t(period, 0, 0), _target(target), _count(count) {}
+    void init() override {
+        thread_t::init();
+        _sent = false;
+    }
+    void fun() override {
+        if (_sent)
+            return;
+        for (size_t i = 0; i < _count; ++i) {
+            network::message_t msg;
+            send_message(_target, msg);
+        }
+        _sent = true;
+    }
+
+private:
+    size_t _target, _count;
+    bool _sent = false;
+};
+
+// counts every message found in its process inbox
+class inbox_counter_t : public thread_t {
+public:
+    size_t received = 0;
+    inbox_counter_t() : thread_t(0.5, 0, 0) {}
+    void init() override {
+        thread_t::init();
+        received = 0;
+    }
+    void fun() override {
+        while (receive_message())
+            received++;
+    }
+};
+
+TEST_CASE("batch_scanner_t: drains every due message in one activation", "[network]") {
+    auto g = std::make_shared<global_t>();
+    g->set_horizon(3.0);
+    auto sys = system_t::create(g, "batch_test");
+    auto sender = process_t::create("sender");
+    sender->add_thread(std::make_shared<burst_sender_t>(1, 5));
+    auto receiver = process_t::create("receiver");
+    auto counter = std::make_shared<inbox_counter_t>();
+    receiver->add_thread(counter);
+    sys->add_process(sender);
+    sys->add_process(receiver);
+
+    auto scanner = std::make_shared<batch_scanner_t>(0, 0.25, 0, 0.1);
+    auto net = std::make_shared<network_t>();
+    net->add_thread(scanner);
+    sys->add_network(net);
+
+    std::make_shared<simulator_t>(sys)->run();
+
+    REQUIRE(scanner->forwarded() == 5);
+    REQUIRE(scanner->saved_steps() == 4);
+    REQUIRE(counter->received == 5);
+}
+
+TEST_CASE("batch_scanner_t: respects the batch bound", "[network]") {
+    auto g = std::make_shared<global_t>();
+    g->set_horizon(0.2);
+    auto sys = system_t::create(g, "batch_bound_test");
+    auto sender = process_t::create("sender");
+    sender->add_thread(std::make_shared<burst_sender_t>(1, 5));
+    auto receiver = process_t::create("receiver");
+    receiver->add_thread(std::make_shared<inbox_counter_t>());
+    sys->add_process(sender);
+    sys->add_process(receiver);
+
+    auto scanner = std::make_shared<batch_scanner_t>(2, 1, 0, 0.1);
+    auto net = std::make_shared<network_t>();
+    net->add_thread(scanner);
+    sys->add_network(net);
+
+    // only the activation at t = 0.1 fits in the horizon
+    std::make_shared<simulator_t>(sys)->run();
+    REQUIRE(scanner->forwarded() == 2);
+    REQUIRE(g->get_channel_out()[0].size() == 3);
+}
+
+TEST_CASE("latency_network_t: delivers at the scheduled times", "[network]") {
+    // a thread that never wakes up within the test
+    class idle_thread_t : public thread_t {
+    public:
+        idle_thread_t() : thread_t(1000, 0, 1000) {}
+        void fun() override {}
+    };
+
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "latency_test");
+    auto sender = process_t::create("sender");
+    sender->add_thread(std::make_shared<burst_sender_t>(1, 3, 1000));
+    auto receiver = process_t::create("receiver");
+    receiver->add_thread(std::make_shared<idle_thread_t>());
+    sys->add_process(sender, "a");
+    sys->add_process(receiver, "b");
+
+    auto net = latency_network_t::create([] { return 100.0; });
+    net->set_latency("a", "b", [] { return 2.0; })->set_bandwidth("a", "b", 1.0);
+    sys->add_network(net);
+
+    auto early = std::make_shared<network::message_t>();
+    early->sender = 0;
+    early->receiver = 1;
+    REQUIRE_THROWS_AS(sys->send_message(early), std::logic_error);
+
+    sys->init();
+    sys->step(); // t = 0, burst sent
+    REQUIRE(net->in_flight() == 3);
+    REQUIRE(g->get_channel_out()[0].empty());
+
+    // one message on the link per time unit, each then travelling for 2
+    for (double expected : {3.0, 4.0, 5.0}) {
+        sys->step();
+        REQUIRE(sys->get_current_time() == Catch::Approx(expected));
+    }
+    REQUIRE(net->in_flight() == 0);
+    REQUIRE(g->get_channel_in()[1].size() == 3);
+
+    SECTION("init discards messages in flight and link state") {
+        sys->init();
+        REQUIRE(net->in_flight() == 0);
+        sys->step();
+        sys->step();
+        REQUIRE(sys->get_current_time() == Catch::Approx(3.0));
+    }
+
+    SECTION("messages sent from a process init are kept") {
+        class greeter_t : public thread_t {
+        public:
+            greeter_t() : thread_t(1000, 0, 1000) {}
+            void init() override {
+                thread_t::init();
+                network::message_t msg;
+                send_message(1, msg);
+            }
+            void fun() override {}
+        };
+        sender->add_thread(std::make_shared<greeter_t>());
+        sys->init();
+        REQUIRE(net->in_flight() == 1);
+        sys->step();
+        REQUIRE(sys->get_current_time() == Catch::Approx(0.0));
+        sys->step(); // the greeting, on the link ahead of the burst
+        REQUIRE(sys->get_current_time() == Catch::Approx(3.0));
+    }
+}
+
+TEST_CASE("system_t: outstanding message counters track the output channels", "[network]") {
+    auto g = std::make_shared<global_t>();
+    g->set_horizon(0.2);
+    auto sys = system_t::create(g, "outstanding_test");
+    auto sender = process_t::create("sender");
+    sender->add_thread(std::make_shared<burst_sender_t>(1, 5));
+    auto receiver = process_t::create("receiver");
+    receiver->add_thread(std::make_shared<inbox_counter_t>());
+    sys->add_process(sender, "a");
+    sys->add_process(receiver, "b");
+
+    auto net = std::make_shared<network_t>();
+    net->add_thread(std::make_shared<batch_scanner_t>(2, 1, 0, 0.1));
+    sys->add_network(net);
+
+    std::make_shared<simulator_t>(sys)->run();
+    REQUIRE(sys->outstanding_messages() == g->get_channel_out()[0].size());
+    REQUIRE(sys->outstanding_messages() == 3);
+    REQUIRE(sys->outstanding_messages("a") == 3);
+    REQUIRE(sys->outstanding_messages("b") == 0);
+    REQUIRE_THROWS_AS(sys->outstanding_messages("c"), std::out_of_range);
+
+    sys->init();
+    REQUIRE(sys->outstanding_messages() == 0);
+    REQUIRE(sys->outstanding_messages("a") == 0);
+}
+
+// sends one message to process `target` per activation
+class steady_sender_t : public thread_t {
+public:
+    steady_sender_t(size_t target, double period) : thread_t(period, 0, 0), _target(target) {}
+    void fun() override {
+        network::message_t msg;
+        send_message(_target, msg);
+    }
+
+private:
+    size_t _target;
+};
+
+TEST_CASE("pid_tuner_t: picks gains within bounds and applies them", "[network]") {
+    auto g = std::make_shared<global_t>();
+    g->set_horizon(20.0);
+    g->set_optimizer_budget(4);
+    auto sys = system_t::create(g, "pid_tune_test");
+    for (size_t i = 0; i < 4; ++i) {
+        auto p = process_t::create("p" + std::to_string(i));
+        p->add_thread(std::make_shared<steady_sender_t>((i + 1) % 4, 0.3));
+        p->add_thread(std::make_shared<inbox_counter_t>());
+        sys->add_process(p);
+    }
+    pid_gains_t gains;
+    gains.kp = 0.5;
+    sys->add_pid_network(gains, 2.0);
+    auto scanner = std::dynamic_pointer_cast<pid_scanner_t>(sys->get_networks()[0]->get_threads()[0]);
+    REQUIRE(scanner);
+    REQUIRE(scanner->get_gains().kp == Catch::Approx(0.5));
+    REQUIRE(scanner->get_gains().ki == Catch::Approx(KI));
+
+    pid_gains_t min, max;
+    min.kp = min.ki = min.kd = 0;
+    max.kp = 1;
+    max.ki = 0.5;
+    max.kd = 0.1;
+    auto sim = std::make_shared<simulator_t>(sys);
+    pid_tuner_t tuner(sim);
+    g->set_optimizer_result(-1);
+    g->set_optimizer_optimal_parameters({42});
+    auto best = tuner.tune(min, max);
+
+    REQUIRE(best.kp >= 0);
+    REQUIRE(best.kp <= 1);
+    REQUIRE(best.ki <= 0.5);
+    REQUIRE(best.kd <= 0.1);
+    REQUIRE(scanner->get_gains().kp == Catch::Approx(best.kp));
+    REQUIRE(tuner.get_best_error() >= 0);
+    // the global keeps what it held before tune
+    REQUIRE(g->get_optimizer_result() == -1);
+    REQUIRE(g->get_optimizer_optimal_parameters() == std::vector<double>{42});
+
+    g->set_optimizer_budget(0);
+    REQUIRE_THROWS_AS(tuner.tune(min, max), std::runtime_error);
+    REQUIRE_THROWS_AS(pid_tuner_t(sim, 0), std::runtime_error);
+    auto bare = std::make_shared<simulator_t>(system_t::create(g, "no_pid"));
+    REQUIRE_THROWS_AS(pid_tuner_t(bare), std::runtime_error);
+}
+
+TEST_CASE("shard_scanner_t: shards partition processes and splice new ones", "[network]") {
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "shard_test");
+    std::vector<std::shared_ptr<inbox_counter_t>> counters;
+    for (size_t i = 0; i < 6; ++i) {
+        auto p = process_t::create("p" + std::to_string(i));
+        counters.push_back(std::make_shared<inbox_counter_t>());
+        p->add_thread(counters.back());
+        sys->add_process(p, i < 3 ? "a" : "b");
+    }
+
+    SECTION("by hash") {
+        sys->add_sharded_network(3, shard_mode_t::HASH);
+        auto &threads = sys->get_networks()[0]->get_threads();
+        REQUIRE(threads.size() == 3);
+        for (size_t id = 0; id < 6; ++id) {
+            size_t owners = 0;
+            for (auto &t : threads)
+                owners += std::dynamic_pointer_cast<shard_scanner_t>(t)->owns(id);
+            REQUIRE(owners == 1);
+        }
+    }
+
+    SECTION("by world, delivering everything after spawning a sender") {
+        sys->add_sharded_network(2, shard_mode_t::WORLD);
+        auto &threads = sys->get_networks()[0]->get_threads();
+        for (auto &t : threads) {
+            auto shard = std::dynamic_pointer_cast<shard_scanner_t>(t);
+            REQUIRE(shard->owns(0) == shard->owns(2));
+            REQUIRE(shard->owns(3) == shard->owns(5));
+        }
+
+        sys->init();
+        sys->step();
+        auto sender = process_t::create("late_sender");
+        sender->add_thread(std::make_shared<burst_sender_t>(0, 4, 1000));
+        sys->add_process(sender, "b");
+        sender->init();
+        while (sys->get_current_time() < 10)
+            sys->step();
+        REQUIRE(sys->outstanding_messages() == 0);
+        REQUIRE(counters[0]->received == 4);
+    }
+}
+
+TEST_CASE("scanner_t: incremental registration keeps rounds consistent", "[network]") {
+    // exposes the scanner list to check its invariants
+    class probe_scanner_t : public scanner_t {
+    public:
+        probe_scanner_t() : scanner_t(1, 0, 0) {}
+        const std::vector<size_t> &order() const { return _scanner; }
+        size_t current() const { return _current; }
+        bool consistent() const {
+            for (size_t i = 0; i < _scanner.size(); ++i)
+                if (_position[_scanner[i]] != i)
+                    return false;
+            return true;
+        }
+    };
+
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "register_test");
+    for (size_t i = 0; i < 6; ++i) {
+        auto p = process_t::create("p" + std::to_string(i));
+        p->add_thread(std::make_shared<inbox_counter_t>());
+        sys->add_process(p);
+    }
+    auto scanner = std::make_shared<probe_scanner_t>();
+    auto net = std::make_shared<network_t>();
+    net->add_thread(scanner);
+    sys->add_network(net);
+    sys->init();
+
+    scanner->fun();
+    scanner->fun();
+    REQUIRE(scanner->current() == 2);
+    std::vector<size_t> visited(scanner->order().begin(), scanner->order().begin() + 2);
+    const size_t pending = scanner->order()[4];
+
+    scanner->unregister_id(visited[0]);
+    scanner->unregister_id(pending);
+    REQUIRE(scanner->order().size() == 4);
+    REQUIRE(scanner->current() == 1);
+    REQUIRE(scanner->order()[0] == visited[1]);
+    REQUIRE(scanner->consistent());
+
+    scanner->register_id(pending);
+    scanner->register_id(pending);
+    REQUIRE(scanner->order().size() == 5);
+    REQUIRE(scanner->current() == 1);
+    REQUIRE(scanner->consistent());
+
+    SECTION("a process added mid-round joins it without resetting the scanner") {
+        scanner->set_thread_time(5.0);
+        auto p = process_t::create("late");
+        p->add_thread(std::make_shared<inbox_counter_t>());
+        sys->add_process(p);
+        scanner->fun();
+        REQUIRE(scanner->get_thread_time() == 5.0);
+        REQUIRE(scanner->order().size() == 6);
+        REQUIRE(scanner->current() == 2);
+        REQUIRE(scanner->consistent());
+
+        // the rest of the round visits every remaining process exactly once
+        std::set<size_t> rest(scanner->order().begin() + 2, scanner->order().end());
+        REQUIRE(rest.size() == 4);
+        REQUIRE(rest.count(visited[0]) == 0);
+    }
+}
+
+TEST_CASE("system_t: retire and spawn reuse slots and drop stale messages", "[system]") {
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "spawn_test");
+    std::vector<process_handle_t> handles;
+    for (size_t i = 0; i < 3; ++i) {
+        auto p = process_t::create("p" + std::to_string(i));
+        p->add_thread(std::make_shared<inbox_counter_t>());
+        handles.push_back(sys->spawn_process(p, "w"));
+    }
+    auto net = std::make_shared<network_t>();
+    auto scanner = std::make_shared<scanner_t>(1, 0, 0);
+    net->add_thread(scanner);
+    sys->add_network(net);
+    sys->init();
+
+    // p0 -> p1 waits in p0's output channel, p1 -> p2 in p1's
+    auto m01 = std::make_shared<network::message_t>();
+    m01->sender = 0;
+    m01->receiver = 1;
+    sys->send_message(m01);
+    auto m12 = std::make_shared<network::message_t>();
+    m12->sender = 1;
+    m12->receiver = 2;
+    sys->send_message(m12);
+    REQUIRE(sys->outstanding_messages("w") == 2);
+
+    sys->retire_process(handles[1]);
+    REQUIRE_FALSE(sys->is_alive(handles[1]));
+    REQUIRE(sys->get_processes()[1] == nullptr);
+    REQUIRE(sys->live_processes().size() == 2);
+    REQUIRE(sys->outstanding_messages("w") == 1);
+    REQUIRE(sys->world_size("w") == 2);
+    REQUIRE(sys->get_processes()[2]->get_relative_id().value() == 1);
+    REQUIRE_THROWS_AS(sys->retire_process(handles[1]), std::out_of_range);
+
+    auto late = process_t::create("late");
+    auto late_counter = std::make_shared<inbox_counter_t>();
+    late->add_thread(late_counter);
+    auto handle = sys->spawn_process(late, "w");
+    REQUIRE(handle.id == 1);
+    REQUIRE(handle.generation != handles[1].generation);
+    REQUIRE(sys->is_alive(handle));
+    REQUIRE(late->get_relative_id().value() == 1);
+    REQUIRE(sys->get_processes()[2]->get_relative_id().value() == 2);
+
+    // the message addressed to the retired process is not delivered to the new one
+    while (sys->get_current_time() < 10)
+        sys->step();
+    REQUIRE(sys->outstanding_messages() == 0);
+    REQUIRE(late_counter->received == 0);
+    REQUIRE(g->get_channel_in()[1].empty());
+}
+
+TEST_CASE("system_t: a message sent to a retired ID is not delivered to the next process in the slot", "[system]") {
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "dead_id_test");
+    std::vector<process_handle_t> handles;
+    for (size_t i = 0; i < 2; ++i) {
+        auto p = process_t::create("p" + std::to_string(i));
+        p->add_thread(std::make_shared<inbox_counter_t>());
+        handles.push_back(sys->spawn_process(p, "w"));
+    }
+    sys->add_network(1, 0, 0);
+    sys->init();
+
+    sys->retire_process(handles[1]);
+    auto msg = std::make_shared<network::message_t>();
+    msg->sender = 0;
+    msg->receiver = 1;
+    sys->send_message(msg);
+
+    auto late = process_t::create("late");
+    auto late_counter = std::make_shared<inbox_counter_t>();
+    late->add_thread(late_counter);
+    REQUIRE(sys->spawn_process(late, "w").id == 1);
+
+    while (sys->get_current_time() < 10)
+        sys->step();
+    REQUIRE(sys->outstanding_messages() == 0);
+    REQUIRE(late_counter->received == 0);
+    REQUIRE(g->get_channel_in()[1].empty());
+
+    auto stray = std::make_shared<network::message_t>();
+    stray->sender = 0;
+    stray->receiver = 7;
+    REQUIRE_THROWS_AS(sys->send_message(stray), std::out_of_range);
+}
+
+TEST_CASE("system_t: init restores the population of an open system", "[system]") {
+    // a customer arrives at every run of the door, the first customer leaves on its second run
+    class door_t : public thread_t {
+    public:
+        size_t runs = 0;
+        door_t() : thread_t(1, 0, 0) {}
+        void init() override {
+            thread_t::init();
+            runs = 0;
+        }
+        void fun() override {
+            auto system = get_process()->get_system();
+            system->spawn_process(process_t::create("customer")->add_thread(std::make_shared<inbox_counter_t>()),
+                                  "customers");
+            if (++runs == 2)
+                system->retire_process(system->get_handle(1));
+        }
+    };
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "open_test");
+    auto door = std::make_shared<door_t>();
+    sys->add_process(process_t::create("door")->add_thread(door), "doors");
+    auto first = process_t::create("first");
+    first->add_thread(std::make_shared<inbox_counter_t>());
+    sys->add_process(first, "customers");
+
+    std::vector<std::vector<std::string>> runs;
+    for (size_t run = 0; run < 2; ++run) {
+        sys->init();
+        REQUIRE(sys->live_processes().size() == 2);
+        REQUIRE(sys->get_processes()[1] == first);
+        REQUIRE(first->get_relative_id().value() == 0);
+        REQUIRE(sys->world_size("customers") == 1);
+        // four arrivals, the first customer left and its slot reused
+        while (door->runs < 4)
+            sys->step();
+        REQUIRE(sys->live_processes().size() == 5);
+        REQUIRE(sys->get_processes()[1] != first);
+        std::vector<std::string> names;
+        for (auto &p : sys->get_processes())
+            names.push_back(p ? p->get_world_key().value() : "");
+        runs.push_back(names);
+    }
+    // same IDs for the processes spawned by every run
+    REQUIRE(runs[0] == runs[1]);
+}
+
+TEST_CASE("system_t: only active processes and threads are scheduled", "[system]") {
+    // counts its own activations
+    class ticker_t : public thread_t {
+    public:
+        size_t ticks = 0;
+        ticker_t() : thread_t(1, 0, 0) {}
+        void fun() override { ticks++; }
+    };
+
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "active_test");
+    auto p0 = process_t::create("p0");
+    auto awake = std::make_shared<ticker_t>();
+    auto asleep = std::make_shared<ticker_t>();
+    p0->add_thread(awake);
+    p0->add_thread(asleep);
+    auto p1 = process_t::create("p1");
+    auto other = std::make_shared<ticker_t>();
+    p1->add_thread(other);
+    sys->add_process(p0);
+    sys->add_process(p1);
+    sys->init();
+
+    asleep->set_active(false);
+    p1->set_active(false);
+    while (sys->get_current_time() < 5)
+        sys->step();
+    REQUIRE(awake->ticks >= 5);
+    REQUIRE(asleep->ticks == 0);
+    REQUIRE(other->ticks == 0);
+
+    // reactivation resumes from the current time
+    asleep->set_active(true);
+    p1->set_active(true);
+    REQUIRE(asleep->get_thread_time() == sys->get_current_time());
+    while (sys->get_current_time() < 10)
+        sys->step();
+    REQUIRE(asleep->ticks >= 4);
+    REQUIRE(other->ticks >= 4);
+
+    SECTION("init reactivates everything") {
+        p0->set_active(false);
+        asleep->set_active(false);
+        sys->init();
+        sys->step();
+        REQUIRE(p0->is_active());
+        REQUIRE(asleep->is_active());
+        REQUIRE(sys->get_current_time() == 0);
+    }
+}
+
+TEST_CASE("system_t: scheduling order does not depend on (de)activations", "[system]") {
+    static std::vector<size_t> order;
+    class tagged_t : public thread_t {
+    public:
+        size_t tag;
+        tagged_t(size_t tag) : thread_t(1, 0, 0), tag(tag) {}
+        void fun() override { order.push_back(tag); }
+    };
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "order_test");
+    std::vector<std::shared_ptr<process_t>> procs;
+    std::vector<std::shared_ptr<thread_t>> threads;
+    for (size_t i = 0; i < 3; ++i) {
+        procs.push_back(process_t::create("p" + std::to_string(i)));
+        sys->add_process(procs.back());
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        threads.push_back(std::make_shared<tagged_t>(10 + i));
+        procs[1]->add_thread(threads.back());
+    }
+    procs[0]->add_thread(std::make_shared<tagged_t>(0));
+    procs[2]->add_thread(std::make_shared<tagged_t>(2));
+    sys->init();
+
+    procs[0]->set_active(false);
+    threads[0]->set_active(false);
+    procs[0]->set_active(true);
+    threads[0]->set_active(true);
+    order.clear();
+    sys->step();
+    REQUIRE(order == std::vector<size_t>{0, 10, 11, 12, 2});
+}
+
+// ============================================================================
+// SECTION 11: populations
+// ============================================================================
+
+TEST_CASE("population_t: entities firing together run as one batch", "[population]") {
+    auto g = std::make_shared<global_t>();
+    g->set_horizon(10.0);
+    auto sys = system_t::create(g, "population_test");
+    size_t calls = 0, largest = 0;
+    auto pop = utils::population_t::create(1000, [&](utils::population_t &p, const std::vector<size_t> &due) {
+        auto &x = p.column(0);
+        for (auto i : due)
+            x[i] += 1;
+        calls++;
+        largest = std::max(largest, due.size());
+    }, 1.0);
+    pop->add_column("x", [](size_t i) { return static_cast<double>(i); });
+    sys->add_process(pop);
+
+    std::make_shared<simulator_t>(sys)->run();
+    REQUIRE(pop->batches() == calls);
+    REQUIRE(largest == 1000);
+    REQUIRE(calls == 11); // t = 0, 1, ..., 10
+    REQUIRE(pop->column("x")[0] == Catch::Approx(11));
+    REQUIRE(pop->column("x")[999] == Catch::Approx(1010));
+    REQUIRE_THROWS_AS(pop->column("y"), std::out_of_range);
+
+    SECTION("per-entity sleep and parking split the batches") {
+        calls = 0;
+        sys->init();
+        pop->set_entity_sleep(0, 1.0);
+        pop->set_entity_time(1, std::numeric_limits<double>::infinity());
+        while (sys->get_current_time() < 10)
+            sys->step();
+        REQUIRE(pop->column("x")[0] == Catch::Approx(6));
+        REQUIRE(pop->column("x")[1] == Catch::Approx(1));
+        REQUIRE(pop->column("x")[2] == Catch::Approx(13));
+        REQUIRE(calls == 11);
+    }
+}
+
+TEST_CASE("static helper threads: inlined callbacks behave like the std::function ones", "[utils]") {
+    auto g = std::make_shared<global_t>();
+    g->set_horizon(10.0);
+    auto sys = system_t::create(g, "static_helpers_test");
+
+    auto server = cs::server_t::create_static_process<cs::request_t>(2, [](size_t) { return size_t(0); }, 0.5,
+        [](thread_t &th, std::shared_ptr<cs::request_t> msg) {
+            th.get_process<cs::server_t>()->database[msg->item] += msg->quantity;
+        });
+    auto supplier = cs::supplier_t::create_static_process(1.0, [] { return size_t(0); },
+        [](size_t) { return size_t(1); }, [](size_t) { return size_t(3); }, "servers");
+    auto vehicle = uv::vehicle_t::create_static_process(1, 1.0, [](size_t) { return 0.0; },
+        [](size_t) { return 2.0; }, [](thread_t &th) {
+            auto v = th.get_process<uv::vehicle_t>();
+            v->pos[0] += v->vel[0];
+        });
+    sys->add_process(server, "servers");
+    sys->add_process(supplier, "suppliers");
+    sys->add_process(vehicle, "vehicles");
+    sys->add_network(0.01, 0.01);
+
+    std::make_shared<simulator_t>(sys)->run();
+    REQUIRE(server->database[0] == 0);
+    REQUIRE(server->database[1] >= 27);
+    REQUIRE(server->database[1] % 3 == 0);
+    REQUIRE(vehicle->pos[0] >= 20.0);
+}
+
+TEST_CASE("system_t: world keys are interned into dense ids", "[system]") {
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "world_ids_test");
+    auto a0 = process_t::create("a0");
+    auto b0 = process_t::create("b0");
+    auto a1 = process_t::create("a1");
+    sys->add_process(a0, "a");
+    sys->add_process(b0, "b");
+    sys->add_process(a1, "a");
+
+    REQUIRE(sys->world_id("a") == 0);
+    REQUIRE(sys->world_id("b") == 1);
+    REQUIRE(sys->world_key(1) == "b");
+    REQUIRE(a1->get_world_id().value() == 0);
+    REQUIRE_THROWS_AS(sys->world_id("c"), std::out_of_range);
+    REQUIRE_THROWS_AS(sys->world_key(2), std::out_of_range);
+
+    auto msg = std::make_shared<network::message_t>();
+    msg->sender = 1;
+    msg->receiver = 0;
+    sys->send_message(msg);
+    REQUIRE(msg->world_id == 1);
+    STATIC_REQUIRE(sizeof(network::message_t) <= 64);
+}
+
+TEST_CASE("system_t: typed views are cached until the world changes", "[system]") {
+    class tagged_t : public process_t {
+    public:
+        tagged_t() : process_t("tagged") {}
+    };
+    auto sys = system_t::create(std::make_shared<global_t>(), "view_test");
+    auto t0 = std::make_shared<tagged_t>();
+    sys->add_process(t0, "w");
+    sys->add_process(process_t::create("plain"), "w");
+    auto h1 = sys->spawn_process(std::make_shared<tagged_t>(), "w");
+
+    auto &view = sys->get_view<tagged_t>("w");
+    REQUIRE(view.size() == 2);
+    REQUIRE(view[0] == t0.get());
+    REQUIRE(&sys->get_view<tagged_t>("w") == &view);
+    REQUIRE(sys->get_view<process_t>("w").size() == 3);
+    REQUIRE_THROWS_AS(sys->get_view<tagged_t>("none"), std::out_of_range);
+
+    // the same reference is refreshed after retirements and spawns
+    sys->retire_process(h1);
+    REQUIRE(sys->get_view<tagged_t>("w").size() == 1);
+    REQUIRE(view.size() == 1);
+    sys->add_process(std::make_shared<tagged_t>(), "v");
+    REQUIRE(view.size() == 1);
+    sys->add_process(std::make_shared<tagged_t>(), "w");
+    REQUIRE(sys->get_view<tagged_t>("w").size() == 2);
+}
+
+TEST_CASE("task_thread_t: resumes exactly when its waits end", "[thread]") {
+    class chain_t : public task_thread_t {
+    public:
+        std::vector<double> resumed;
+        void init() override {
+            task_thread_t::init();
+            resumed.clear();
+        }
+        void run() override {
+            sleep(1, [this]() {
+                resumed.push_back(get_thread_time());
+                receive([this](std::shared_ptr<network::message_t> msg) {
+                    REQUIRE(msg);
+                    resumed.push_back(get_thread_time());
+                    wait_until(7, [this]() { resumed.push_back(get_thread_time()); });
+                });
+            });
+        }
+    };
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "task_test");
+    auto sender = process_t::create("sender");
+    sender->add_thread(std::make_shared<burst_sender_t>(1, 1, 100));
+    auto receiver = process_t::create("receiver");
+    auto task = std::make_shared<chain_t>();
+    receiver->add_thread(task);
+    sys->add_process(sender);
+    sys->add_process(receiver);
+    sys->add_network(latency_network_t::create([]() { return 4.0; }));
+    sys->init();
+
+    while (sys->get_current_time() < 1)
+        sys->step();
+    // parked until the delivery, out of the scheduler
+    REQUIRE(std::isinf(task->get_thread_time()));
+    REQUIRE(receiver->next_update_time() == std::numeric_limits<double>::infinity());
+
+    while (sys->get_current_time() < 10)
+        sys->step();
+    REQUIRE(task->resumed == std::vector<double>{1, 4, 7});
+    REQUIRE(task->finished());
+    REQUIRE_FALSE(task->is_active());
+
+    // init restarts the task
+    sys->init();
+    REQUIRE_FALSE(task->finished());
+    REQUIRE(task->is_active());
+}
+
+TEST_CASE("thread_t: wake on delivery threads run only when messages arrive", "[thread]") {
+    class lazy_counter_t : public inbox_counter_t {
+    public:
+        size_t runs = 0;
+        double last_run = 0;
+        lazy_counter_t() { set_wake_on_delivery(true); }
+        void fun() override {
+            runs++;
+            last_run = get_thread_time();
+            inbox_counter_t::fun();
+        }
+    };
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "wake_test");
+    auto sender = process_t::create("sender");
+    sender->add_thread(std::make_shared<burst_sender_t>(1, 3, 100));
+    auto receiver = process_t::create("receiver");
+    auto counter = std::make_shared<lazy_counter_t>();
+    receiver->add_thread(counter);
+    sys->add_process(sender);
+    sys->add_process(receiver);
+    sys->add_network(latency_network_t::create([]() { return 4.0; }));
+    sys->init();
+
+    sys->step();
+    REQUIRE(std::isinf(counter->get_thread_time()));
+    while (sys->get_current_time() < 50)
+        sys->step();
+    // a single activation at the delivery time instead of one every 0.5
+    REQUIRE(counter->runs == 1);
+    REQUIRE(counter->last_run == 4);
+    REQUIRE(counter->received == 3);
+    REQUIRE(counter->wakes_on_delivery());
+}
+
+TEST_CASE("system_t: integer time base keeps periodic threads on exact ticks", "[system]") {
+    class periodic_t : public thread_t {
+    public:
+        periodic_t() : thread_t(0.1, 0, 0) {}
+        void fun() override {}
+    };
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "tick_test");
+    REQUIRE(sys->get_tick() == 0);
+    REQUIRE_THROWS_AS(sys->set_tick(-1), std::runtime_error);
+    REQUIRE_THROWS_AS(sys->to_ticks(1.0), std::logic_error);
+    REQUIRE_THROWS_AS(sys->to_time(1), std::logic_error);
+    sys->set_tick(0.1);
+    REQUIRE(sys->to_ticks(0.34) == 3);
+    REQUIRE(sys->to_time(3) == 3 * 0.1);
+
+    std::vector<std::shared_ptr<periodic_t>> threads;
+    for (size_t i = 0; i < 2; ++i) {
+        threads.push_back(std::make_shared<periodic_t>());
+        sys->add_process(process_t::create("p" + std::to_string(i))->add_thread(threads.back()));
+    }
+    sys->init();
+    while (sys->get_current_time() < 1000)
+        sys->step();
+    // noise and floating point sums do not separate the two threads or drift them off the grid
+    REQUIRE(threads[0]->get_thread_time() == threads[1]->get_thread_time());
+    REQUIRE(threads[0]->get_thread_time() == sys->to_time(10001));
+    REQUIRE(sys->get_current_time() == sys->to_time(10000));
+}
+
+TEST_CASE("system_t: systems are freed with their processes and threads", "[system]") {
+    std::weak_ptr<system_t> weak_sys;
+    std::weak_ptr<process_t> weak_proc;
+    std::weak_ptr<thread_t> weak_thread;
+    for (size_t run = 0; run < 3; ++run) {
+        auto g = std::make_shared<global_t>();
+        g->set_horizon(5.0);
+        auto sys = system_t::create(g, "free_test");
+        auto sender = process_t::create("sender");
+        auto thread = std::make_shared<steady_sender_t>(1, 0.5);
+        sender->add_thread(thread);
+        auto receiver = process_t::create("receiver");
+        receiver->add_thread(std::make_shared<inbox_counter_t>());
+        sys->add_process(sender);
+        sys->add_process(receiver);
+        sys->add_network(1, 0, 0);
+        simulator_t sim(sys);
+        sim.run();
+        weak_sys = sys;
+        weak_proc = sender;
+        weak_thread = thread;
+    }
+    // back-references do not keep the last run alive
+    REQUIRE(weak_sys.expired());
+    REQUIRE(weak_proc.expired());
+    REQUIRE(weak_thread.expired());
+}
+
+TEST_CASE("system_t: a process may retire itself from one of its threads", "[system]") {
+    static bool destroyed;
+    // the customer leaves: retires its own process on its second run
+    class leaver_t : public thread_t {
+    public:
+        size_t runs = 0;
+        leaver_t() : thread_t(1, 0, 0) {}
+        ~leaver_t() { destroyed = true; }
+        void fun() override {
+            if (++runs == 2) {
+                auto system = get_process()->get_system();
+                system->retire_process(system->get_handle(get_process()->get_id().value()));
+            }
+        }
+    };
+    destroyed = false;
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "leave_test");
+    sys->spawn_process(process_t::create("other")->add_thread(std::make_shared<inbox_counter_t>()), "customers");
+    sys->init();
+    sys->step();
+    // spawned during the run and without other references, the system slot is its only owner
+    sys->spawn_process(process_t::create("customer")->add_thread(std::make_shared<leaver_t>()), "customers");
+    while (sys->live_processes().size() == 2)
+        sys->step();
+    // the process and its thread are released once the step is over
+    REQUIRE(destroyed);
+    REQUIRE(sys->world_size("customers") == 1);
+    sys->step();
+}
+
+TEST_CASE("system_t: emplaced processes and threads are contiguous and freed with the system", "[system]") {
+    static size_t destroyed;
+    class counted_process_t : public process_t {
+    public:
+        counted_process_t(const std::string &name) : process_t(name) {}
+        ~counted_process_t() { destroyed++; }
+    };
+    class counted_thread_t : public thread_t {
+    public:
+        size_t runs = 0;
+        counted_thread_t(double c_time) : thread_t(c_time, 0, 0) {}
+        ~counted_thread_t() { destroyed++; }
+        void fun() override { runs++; }
+    };
+    destroyed = 0;
+    {
+        auto g = std::make_shared<global_t>();
+        auto sys = system_t::create(g, "arena_test");
+        std::vector<std::shared_ptr<counted_process_t>> procs;
+        std::vector<std::shared_ptr<counted_thread_t>> threads;
+        for (size_t i = 0; i < 10; ++i) {
+            procs.push_back(sys->emplace_process<counted_process_t>("w", "p" + std::to_string(i)));
+            threads.push_back(sys->emplace_thread<counted_thread_t>(procs.back(), 1.0));
+        }
+        for (size_t i = 1; i < 10; ++i) {
+            REQUIRE(procs[i].get() == procs[i - 1].get() + 1);
+            REQUIRE(threads[i].get() == threads[i - 1].get() + 1);
+        }
+        REQUIRE(sys->world_size("w") == 10);
+        REQUIRE(procs[3]->get_id().value() == 3);
+
+        sys->init();
+        while (sys->get_current_time() < 5)
+            sys->step();
+        // noise decides whether the runs due at t=5 fall within the loop
+        for (auto &thread : threads)
+            REQUIRE(thread->runs >= 5);
+        sys->retire_process(sys->get_handle(0));
+        REQUIRE(destroyed == 0);
+
+        // a process spawned and retired during the run is freed at once, and its cells reused
+        auto late = sys->emplace_process<counted_process_t>("w", "late");
+        sys->emplace_thread<counted_thread_t>(late, 1.0);
+        auto *cell = late.get();
+        const size_t id = late->get_id().value();
+        late = nullptr;
+        sys->retire_process(sys->get_handle(id));
+        REQUIRE(destroyed == 2);
+        REQUIRE(sys->emplace_process<counted_process_t>("w", "later").get() == cell);
+    }
+    REQUIRE(destroyed == 23);
+}
+
+TEST_CASE("value_network_t: delivers variant messages by value", "[network]") {
+    struct ping_t { int n = 0; };
+    struct pong_t { double x = 0; };
+    using value_net_t = value_network_t<std::variant<ping_t, pong_t>>;
+    class idle_t : public thread_t {
+    public:
+        idle_t() : thread_t(100, 0, 100) {}
+        void fun() override {}
+    };
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "value_test");
+    std::vector<std::shared_ptr<idle_t>> threads;
+    for (size_t i = 0; i < 3; ++i) {
+        threads.push_back(std::make_shared<idle_t>());
+        sys->add_process(process_t::create("p" + std::to_string(i))->add_thread(threads.back()));
+    }
+    auto net = value_net_t::create(1);
+    sys->add_network(net);
+    sys->init();
+
+    net->send(*threads[0], 1, ping_t{7});
+    net->send(*threads[0], 1, pong_t{2.5});
+    net->send(*threads[0], 2, ping_t{1});
+    REQUIRE(net->pending() == 3);
+    REQUIRE(net->peek(*threads[1]) == nullptr);
+    REQUIRE_THROWS_AS(net->send(*threads[0], 5, ping_t{}), std::out_of_range);
+
+    sys->retire_process(sys->get_handle(2));
+    sys->step();
+    REQUIRE(sys->get_current_time() == 1);
+    REQUIRE(net->pending() == 0);
+
+    auto front = net->peek(*threads[1]);
+    REQUIRE(front);
+    REQUIRE(front->sender == 0);
+    pong_t pong;
+    REQUIRE_FALSE(net->try_receive(*threads[1], pong)); // the front is a ping, left in place
+    ping_t ping;
+    REQUIRE(net->try_receive(*threads[1], ping));
+    REQUIRE(ping.n == 7);
+    double x = 0;
+    REQUIRE(net->receive(*threads[1], [&x](auto &value) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(value)>, pong_t>)
+            x = value.x;
+    }));
+    REQUIRE(x == 2.5);
+    REQUIRE_FALSE(net->receive(*threads[1], [](auto &) {}));
+}
+
+TEST_CASE("ring_t: popped and cleared slots release their values", "[network]") {
+    auto owned = std::make_shared<int>(1);
+    ring_t<std::shared_ptr<int>> ring;
+    ring.push(std::shared_ptr<int>(owned));
+    ring.push(std::shared_ptr<int>(owned));
+    ring.push(std::shared_ptr<int>(owned));
+    REQUIRE(owned.use_count() == 4);
+    ring.pop();
+    REQUIRE(owned.use_count() == 3);
+    ring.clear();
+    REQUIRE(owned.use_count() == 1);
+    REQUIRE(ring.empty());
+}
+
+TEST_CASE("value_network_t: each message waits its own delay", "[network]") {
+    using value_net_t = value_network_t<std::variant<int>>;
+    class twice_t : public thread_t {
+    public:
+        std::shared_ptr<value_net_t> net;
+        size_t sent = 0;
+        twice_t(std::shared_ptr<value_net_t> net) : thread_t(0.5, 0, 0), net(net) {}
+        void fun() override {
+            if (sent < 2)
+                net->send(*this, 1, static_cast<int>(sent++));
+        }
+    };
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "value_delay_test");
+    auto net = value_net_t::create(1);
+    auto sender = std::make_shared<twice_t>(net);
+    sys->add_process(process_t::create("sender")->add_thread(sender));
+    sys->add_process(process_t::create("receiver"));
+    sys->add_network(net);
+    sys->init();
+
+    // sent at 0 and at 0.5, the second one is not delivered with the first
+    while (sys->get_current_time() < 1)
+        sys->step();
+    REQUIRE(net->pending() == 1);
+    while (net->pending() > 0)
+        sys->step();
+    REQUIRE(sys->get_current_time() == Catch::Approx(1.5).margin(0.01));
+}
+
+TEST_CASE("thread_t: selective receive sets other messages aside", "[thread]") {
+    struct a_msg : network::message_t {};
+    struct b_msg : network::message_t {};
+    class idle_t : public thread_t {
+    public:
+        idle_t() : thread_t(100, 0, 100) {}
+        void fun() override {}
+    };
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "selective_test");
+    auto thread = std::make_shared<idle_t>();
+    sys->add_process(process_t::create("p")->add_thread(thread));
+    sys->init();
+    auto deliver = [&sys](std::shared_ptr<network::message_t> msg, size_t tag) {
+        msg->receiver = 0;
+        msg->tag = tag;
+        sys->deliver(msg);
+    };
+    deliver(std::make_shared<b_msg>(), 1);
+    deliver(std::make_shared<a_msg>(), 2);
+    deliver(std::make_shared<b_msg>(), 2);
+    deliver(std::make_shared<a_msg>(), 1);
+
+    auto a = thread->receive_selective<a_msg>();
+    REQUIRE(a);
+    REQUIRE(a->tag == 2);
+    auto b = thread->receive_selective<b_msg>(2);
+    REQUIRE(b);
+    REQUIRE(b->tag == 2);
+    b = thread->receive_selective<b_msg>();
+    REQUIRE(b);
+    REQUIRE(b->tag == 1);
+    REQUIRE(thread->receive_selective<a_msg>(3) == nullptr);
+    // the tag 1 a_msg has been set aside, not lost
+    REQUIRE(thread->has_message());
+    auto any = thread->receive_selective<network::message_t>();
+    REQUIRE(any);
+    REQUIRE(std::dynamic_pointer_cast<a_msg>(any));
+    REQUIRE(any->tag == 1);
+    REQUIRE_FALSE(thread->has_message());
+
+    // receive_message takes the set aside messages first, in arrival order
+    deliver(std::make_shared<a_msg>(), 1);
+    deliver(std::make_shared<b_msg>(), 5);
+    deliver(std::make_shared<a_msg>(), 5);
+    REQUIRE(thread->receive_selective<b_msg>(7) == nullptr);
+    REQUIRE(std::dynamic_pointer_cast<a_msg>(thread->receive_message()));
+    auto tagged = thread->receive_selective<network::message_t>(5);
+    REQUIRE(std::dynamic_pointer_cast<b_msg>(tagged));
+    REQUIRE(std::dynamic_pointer_cast<a_msg>(thread->receive_message()));
+    REQUIRE_FALSE(thread->has_message());
+}
+
+TEST_CASE("thread_t: broadcast and multicast share a single message", "[network]") {
+    struct price_msg : network::message_t {
+        double price = 0;
+    };
+    class listener_t : public thread_t {
+    public:
+        std::vector<std::shared_ptr<price_msg>> received;
+        listener_t() : thread_t(1, 0, 0) {}
+        void fun() override {
+            while (auto msg = receive_message<price_msg>())
+                received.push_back(msg);
+        }
+    };
+    class idle_t : public thread_t {
+    public:
+        idle_t() : thread_t(100, 0, 100) {}
+        void fun() override {}
+    };
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "multicast_test");
+    auto sender = std::make_shared<idle_t>();
+    sys->spawn_process(process_t::create("market")->add_thread(sender), "market");
+    std::vector<std::shared_ptr<listener_t>> listeners;
+    std::vector<process_handle_t> handles;
+    for (size_t i = 0; i < 3; ++i) {
+        listeners.push_back(std::make_shared<listener_t>());
+        handles.push_back(sys->spawn_process(process_t::create("trader")->add_thread(listeners.back()), "traders"));
+    }
+    sys->add_network(1, 0, 0);
+    sys->init();
+
+    price_msg price;
+    price.price = 42;
+    sender->broadcast("traders", price);
+    REQUIRE(sys->outstanding_messages() == 1);
+    // periods carry noise, step until delivered and read with a generous time bound
+    auto received = [&listeners](size_t i, size_t count) { return listeners[i]->received.size() >= count; };
+    while (!(received(0, 1) && received(1, 1) && received(2, 1)) && sys->get_current_time() < 50)
+        sys->step();
+    REQUIRE(sys->outstanding_messages() == 0);
+    for (auto &listener : listeners) {
+        REQUIRE(listener->received.size() == 1);
+        REQUIRE(listener->received[0] == listeners[0]->received[0]);
+    }
+    REQUIRE(listeners[0]->received[0]->price == 42);
+    REQUIRE(listeners[0]->received[0]->receiver == network::multicast_receiver);
+
+    // receivers retired before delivery are skipped
+    price.price = 43;
+    sender->multicast({handles[0].id, handles[2].id}, price);
+    sys->retire_process(handles[2]);
+    while (!received(0, 2) && sys->get_current_time() < 50)
+        sys->step();
+    // one more activation of the other listeners, a stray delivery would have been read by now
+    for (const double until = sys->get_current_time() + 2; sys->get_current_time() < until;)
+        sys->step();
+    REQUIRE(listeners[0]->received.size() == 2);
+    REQUIRE(listeners[0]->received[1]->price == 43);
+    REQUIRE(listeners[1]->received.size() == 1);
+    REQUIRE(listeners[2]->received.size() == 1);
+
+    REQUIRE_THROWS_AS(sender->multicast({handles[2].id}, price), std::out_of_range);
+    REQUIRE_THROWS_AS(sender->broadcast("nobody", price), std::out_of_range);
+}
+
+TEST_CASE("system_t: replicas are reset from init images", "[system]") {
+    size_t fills = 0;
+    auto server = cs::server_t::create_static_process<cs::request_t>(4, [&fills](size_t i) { fills++; return i; },
+        1, [](thread_t &, std::shared_ptr<cs::request_t>) {});
+    auto vehicle = uv::vehicle_t::create_static_process(2, 1.0, [](size_t i) { return double(i); },
+        [](size_t) { return 1.0; }, [](thread_t &) {});
+    server->set_init_image(true);
+    vehicle->set_init_image(true);
+
+    auto g = std::make_shared<global_t>();
+    auto sys = system_t::create(g, "reset_test");
+    sys->add_process(server, "servers");
+    sys->add_process(vehicle, "vehicles");
+    sys->init();
+    REQUIRE(fills == 4);
+    REQUIRE(sys->get_reset_time() >= 0);
+
+    server->database[2] = 100;
+    vehicle->pos[1] = 50;
+    auto msg = std::make_shared<network::message_t>();
+    msg->sender = 0;
+    msg->receiver = 1;
+    sys->send_message(msg);
+    REQUIRE(g->get_channel_out()[0].size() == 1);
+
+    sys->init();
+    REQUIRE(fills == 4);
+    REQUIRE(server->database == std::vector<size_t>{0, 1, 2, 3});
+    REQUIRE(vehicle->pos == std::vector<double>{0, 1});
+    REQUIRE(vehicle->vel == std::vector<double>{1, 1});
+    REQUIRE(g->get_channel_out()[0].empty());
+    REQUIRE(sys->outstanding_messages() == 0);
+
+    // without the image the init functions run again
+    server->set_init_image(false);
+    sys->init();
+    REQUIRE(fills == 8);
+}